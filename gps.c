@@ -6,6 +6,8 @@
  */
 
 #include "gps.h"
+#include "gps_prof.h"
+#include "gps_buff.h"
 
 #include <math.h>
 #include <string.h>
@@ -13,8 +15,36 @@
 
 #define STAT_UNKNOWN        0
 #define STAT_GGA            1
+#define STAT_GSV            3
 #define STAT_RMC            4
 
+#define GGA_FIELDS          14                  /* Minimal number of data fields after sentence type */
+#define GSV_FIELDS          3
+#define RMC_FIELDS          11
+
+#define UBX_SYNC1           0xB5
+#define UBX_SYNC2           0x62
+#define UBX_NAV             0x01
+#define UBX_NAV_PVT         0x07
+#define UBX_MAX_LEN         1024                /* Longer frames are considered corrupted */
+
+/* UBX frame decoder states */
+#define UBX_IDLE            0
+#define UBX_S_SYNC2         1
+#define UBX_S_CLASS         2
+#define UBX_S_ID            3
+#define UBX_S_LEN1          4
+#define UBX_S_LEN2          5
+#define UBX_S_PAYLOAD       6
+#define UBX_S_CK_A          7
+#define UBX_S_CK_B          8
+
+#define MM_S_TO_KNOTS       FLT(0.001943844)
+
+#define US_PER_DAY          86400000000ULL
+#define MS_PER_DAY          86400000UL
+#define DAYS_TO_2000        10957UL             /* Days from 1970-01-01 to 2000-01-01 */
+
 #define CRC_ADD(_gh, ch)    (_gh)->p.crc_calc ^= (uint8_t)(ch)
 #define TERM_ADD(_gh, ch)   do {    \
     if ((_gh)->p.term_pos < (sizeof((_gh)->p.term_str) - 1)) {  \
@@ -25,12 +55,101 @@
 
 #define CIN(x)              ((x) >= '0' && (x) <= '9')
 #define CTN(x)              ((x) - '0')
-#define CHTN(x)             (((x) >= '0' && (x) <= '9') ? ((x) - '0') : (((x) >= 'a' && (x) <= 'z') ? ((x) - 'a' + 10) : (((x) >= 'A' && (x) <= 'Z') ? ((x) - 'A' + 10) : 0)))
+#define CHX(x)              (CIN(x) || ((x) >= 'a' && (x) <= 'f') || ((x) >= 'A' && (x) <= 'F'))
+#define CHTN(x)             (((x) >= '0' && (x) <= '9') ? ((x) - '0') : (((x) >= 'a' && (x) <= 'f') ? ((x) - 'a' + 10) : (((x) >= 'A' && (x) <= 'F') ? ((x) - 'A' + 10) : 0)))
+#define KEY2(a, b)          (((uint16_t)(uint8_t)(a) << 8) | (uint8_t)(b))
+#define KEY3(a, b, c)       (((uint32_t)(uint8_t)(a) << 16) | ((uint32_t)(uint8_t)(b) << 8) | (uint8_t)(c))
 #define TERM_NEXT(_gh)      do { (_gh)->p.term_str[((_gh)->p.term_pos = 0)] = 0; (_gh)->p.term_num++; } while (0)
 #define FLT(x)              ((gps_float_t)(x))
 
+#if GPS_CFG_COMPACT
+#define GGA(_gh, f)         (_gh)->gga.f        /* Published value in either layout */
+#define RMC(_gh, f)         (_gh)->rmc.f
+#else
+#define GGA(_gh, f)         (_gh)->f
+#define RMC(_gh, f)         (_gh)->f
+#endif /* GPS_CFG_COMPACT */
+
+#if GPS_CFG_STATS
+#define STATS_INC(_gh, cnt) (_gh)->stats.cnt++
+#else
+#define STATS_INC(_gh, cnt)
+#endif /* GPS_CFG_STATS */
+#define DISCARD(_gh, cnt)   do { (_gh)->p.sync = 0; STATS_INC(_gh, cnt); } while (0)    /* Skip bytes until next `$` */
+
+#if GPS_CFG_RX_TIMESTAMP
+#define RX_SIZE             (2 * sizeof(gps_tick_t))
+#else
+#define RX_SIZE             0
+#endif /* GPS_CFG_RX_TIMESTAMP */
+#if GPS_CFG_PROTOCOL_UBX
+#define PDOP_SIZE           sizeof(gps_aux_float_t)
+#else
+#define PDOP_SIZE           0
+#endif /* GPS_CFG_PROTOCOL_UBX */
+
+/* Layout checks: records hold no padding except at the tail, hot fields in first cache line */
+#define PACKED(size, payload)   ((size) - (payload) < sizeof(gps_float_t))
+GPS_STATIC_ASSERT(PACKED(sizeof(gps_gga_t), 2 * sizeof(gps_float_t) + sizeof(gps_epoch_t) + 3 * sizeof(gps_aux_float_t) + PDOP_SIZE + RX_SIZE + 7), gga_packed);
+GPS_STATIC_ASSERT(PACKED(sizeof(gps_rmc_t), 3 * sizeof(gps_aux_float_t) + RX_SIZE + 4), rmc_packed);
+GPS_STATIC_ASSERT(sizeof(gps_rec_t) == sizeof(gps_gga_t), rec_size);
+GPS_STATIC_ASSERT(GPS_CFG_NMEA_MAX_LEN < 256, max_len);
+#if !GPS_CFG_COMPACT
+GPS_STATIC_ASSERT(PACKED(offsetof(gps_t, tmp), 8 * sizeof(gps_float_t) + sizeof(gps_epoch_t) + PDOP_SIZE + 11 + 2 * RX_SIZE), public_packed);
+GPS_STATIC_ASSERT(offsetof(gps_t, seconds) < GPS_CFG_CACHE_LINE, hot_fields);
+#endif /* !GPS_CFG_COMPACT */
+
+/*
+ * Published values and staging area of both layouts, private state after them is the same.
+ * Mirror of active layout must match handle, so compact handle is smaller than flat one
+ */
+#if GPS_CFG_PROTOCOL_UBX
+#define PDOP_COUNT          1
+#else
+#define PDOP_COUNT          0
+#endif /* GPS_CFG_PROTOCOL_UBX */
+typedef struct {
+    struct {
+        double ll[2];
+        gps_epoch_t epoch;
+        float aux[3 + PDOP_COUNT];
+#if GPS_CFG_RX_TIMESTAMP
+        gps_tick_t rx[2];
+#endif /* GPS_CFG_RX_TIMESTAMP */
+        uint8_t b[7];
+    } gga;
+    struct {
+#if GPS_CFG_RX_TIMESTAMP
+        gps_tick_t rx[2];
+#endif /* GPS_CFG_RX_TIMESTAMP */
+        float aux[3];
+        uint8_t b[4];
+    } rmc;
+    struct { double ll[2]; float aux[3 + PDOP_COUNT]; uint8_t b[2]; } tmp;
+} compact_mirror_t;
+typedef struct {
+    double hot[7];
+    uint8_t b[11];
+#if GPS_CFG_RX_TIMESTAMP
+    gps_tick_t rx[4];
+#endif /* GPS_CFG_RX_TIMESTAMP */
+    double dop[1 + PDOP_COUNT];
+    gps_epoch_t epoch;
+    struct { double ll[2]; double aux[3 + PDOP_COUNT]; uint8_t b[2]; } tmp;
+} flat_mirror_t;
+GPS_STATIC_ASSERT(sizeof(compact_mirror_t) < sizeof(flat_mirror_t), compact_smaller);
+GPS_STATIC_ASSERT(offsetof(gps_t, p) == (GPS_CFG_COMPACT ? sizeof(compact_mirror_t) : sizeof(flat_mirror_t)), layout_mirror);
+
+/* Handle with default options is not larger than handle of library before layout options */
+#define GPS_T_SIZE_BASELINE 136
+#if GPS_CFG_COMPACT && !GPS_CFG_PROTOCOL_UBX && !GPS_CFG_STATEMENT_GPGSV && !GPS_CFG_RX_TIMESTAMP && !GPS_CFG_STATS
+GPS_STATIC_ASSERT(sizeof(gps_tick_t) != 4 || sizeof(gps_t) <= GPS_T_SIZE_BASELINE, default_size);
+#endif /* Default options */
+
 /**
  * \brief           Compare calculated CRC with received CRC
+ *
+ *                  Received CRC digits were checked to be hexadecimal when they arrived
  * \param[in]       gh: GPS handle
  * \return          `1` on success, `0` otherwise
  */
@@ -41,6 +160,38 @@ check_crc(gps_t* gh) {
     return gh->p.crc_calc == crc;               /* They must match! */
  }
 
+/**
+ * \brief           Check sentence has all fields library reads
+ * \param[in]       gh: GPS handle, at end of sentence
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+check_fields(gps_t* gh) {
+    uint8_t fields = (uint8_t)(gh->p.term_num - 1);  /* Term after `*` holds CRC */
+
+    return (gh->p.stat == STAT_GGA && fields >= GGA_FIELDS)
+        || (gh->p.stat == STAT_RMC && fields >= RMC_FIELDS)
+        || (gh->p.stat == STAT_GSV && fields >= GSV_FIELDS);
+}
+
+/**
+ * \brief           Decode talker ID of statement
+ * \param[in]       t: Two characters of talker ID
+ * \return          Member of \ref gps_system_t
+ */
+static uint8_t
+parse_talker(const char* t) {
+    switch (KEY2(t[0], t[1])) {
+        case KEY2('G', 'P'): return GPS_SYSTEM_GPS;
+        case KEY2('G', 'L'): return GPS_SYSTEM_GLONASS;
+        case KEY2('G', 'A'): return GPS_SYSTEM_GALILEO;
+        case KEY2('G', 'B'):
+        case KEY2('B', 'D'): return GPS_SYSTEM_BEIDOU;
+        case KEY2('G', 'N'): return GPS_SYSTEM_MULTI;
+        default: return GPS_SYSTEM_UNKNOWN;
+    }
+}
+
 
 /**
  * \brief           Parse number as integer
@@ -105,6 +256,90 @@ parse_lat_long(gps_t* gh) {
     return ll;
 }
 
+/**
+ * \brief           Parse UTC time of day `hhmmss.sss` of current term,
+ *                  up to `6` fractional digits
+ * \param[in]       gh: GPS handle
+ */
+static void
+parse_tod(gps_t* gh) {
+    const char* t = gh->p.term_str;
+    uint32_t sec, frac = 0, scale = 100;
+    uint8_t i;
+
+    for (i = 0; i < 6; i++) {
+        if (!CIN(t[i])) {
+            return;                             /* Empty field, receiver has no time yet */
+        }
+    }
+    sec = ((uint32_t)(10 * CTN(t[0]) + CTN(t[1])) * 60 + (10 * CTN(t[2]) + CTN(t[3]))) * 60 + (10 * CTN(t[4]) + CTN(t[5]));
+    if (t[6] == '.') {
+        for (t += 7; CIN(*t) && scale > 0; t++, scale /= 10) {
+            frac += (uint32_t)CTN(*t) * scale;
+        }
+    }
+    gh->p.tod = sec * 1000UL + frac;
+    gh->p.timed = 1;
+}
+
+/**
+ * \brief           Get number of days from 1970-01-01 to date in years 2000 to 2099
+ * \param[in]       date: Day of month, `1` to `31`
+ * \param[in]       month: Month, `1` to `12`
+ * \param[in]       year: Year since 2000
+ * \return          Number of days
+ */
+static uint16_t
+days_from_civil(uint8_t date, uint8_t month, uint8_t year) {
+    static const uint16_t before[12] = { 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 };
+
+    return (uint16_t)(DAYS_TO_2000 + 365UL * year + (year + 3) / 4 + before[month - 1] + (date - 1)
+        + ((year % 4) == 0 && month > 2));
+}
+
+/**
+ * \brief           Take date of statement time as new calendar reference
+ * \param[in]       gh: GPS handle
+ * \param[in]       date: Day of month, `1` to `31`
+ * \param[in]       month: Month, `1` to `12`
+ * \param[in]       year: Year since 2000
+ */
+static void
+set_date(gps_t* gh, uint8_t date, uint8_t month, uint8_t year) {
+    if (!gh->p.timed || date < 1 || date > 31 || month < 1 || month > 12 || year > 99) {
+        return;
+    }
+    gh->cal.day = days_from_civil(date, month, year);
+    gh->cal.ref = gh->p.tod;
+    gh->cal.timed = 1;
+    gh->cal.dated = 1;
+}
+
+/**
+ * \brief           Get UTC epoch of statement time of day on day nearest to last known time,
+ *                  so midnight is crossed before RMC with new date arrives
+ * \param[in]       gh: GPS handle
+ * \return          Epoch, `0` when statement has no time, see \ref gps_gga_t `timed`
+ */
+static gps_epoch_t
+get_epoch(gps_t* gh) {
+    uint32_t tod = gh->p.tod;
+
+    if (!gh->p.timed) {
+        return 0;
+    }
+    if (gh->cal.timed) {
+        if (tod + MS_PER_DAY / 2 < gh->cal.ref) {   /* Passed midnight */
+            gh->cal.day++;
+        } else if (tod > gh->cal.ref + MS_PER_DAY / 2 && gh->cal.day > 0) {
+            gh->cal.day--;                      /* Late statement of previous day */
+        }
+    }
+    gh->cal.ref = tod;
+    gh->cal.timed = 1;
+    return (gps_epoch_t)gh->cal.day * US_PER_DAY + (gps_epoch_t)tod * 1000U;
+}
+
 /**
  * \brief           Parse received term
  * \param[in]       gh: GPS handle
@@ -112,18 +347,33 @@ parse_lat_long(gps_t* gh) {
  */
 static uint8_t
 parse_term(gps_t* gh) {
-    if (gh->p.term_num == 0) {                  /* Check string type */
-        if (0) {
+    gps_stage_t* r = &gh->tmp;
+
+    if (gh->p.term_num == 0) {                  /* Check talker and statement type, `$TTSSS` */
+        gh->p.stat = STAT_UNKNOWN;              /* Invalid statement for library unless found below */
+        if (gh->p.term_pos != 6
+            || (gh->p.talker = parse_talker(&gh->p.term_str[1])) == GPS_SYSTEM_UNKNOWN) {
+            return 1;
+        }
+        switch (KEY3(gh->p.term_str[3], gh->p.term_str[4], gh->p.term_str[5])) {
 #if GPS_CFG_STATEMENT_GPGGA
-        } else if (!strncmp(gh->p.term_str, "$GPGGA", 6) || !strncmp(gh->p.term_str, "$GNGGA", 6)) {
-            gh->p.stat = STAT_GGA;
+            case KEY3('G', 'G', 'A'):
+                gh->p.stat = STAT_GGA;
+                break;
 #endif /* GPS_CFG_STATEMENT_GPGGA */
 #if GPS_CFG_STATEMENT_GPRMC
-        } else if (!strncmp(gh->p.term_str, "$GPRMC", 6) || !strncmp(gh->p.term_str, "$GNRMC", 6)) {
-            gh->p.stat = STAT_RMC;
+            case KEY3('R', 'M', 'C'):
+                gh->p.stat = STAT_RMC;
+                break;
 #endif /* GPS_CFG_STATEMENT_GPRMC */
-        } else {
-            gh->p.stat = STAT_UNKNOWN;          /* Invalid statement for library */
+#if GPS_CFG_STATEMENT_GPGSV
+            case KEY3('G', 'S', 'V'):
+                if (gh->p.talker != GPS_SYSTEM_MULTI) { /* Satellites must belong to one constellation */
+                    gh->p.stat = STAT_GSV;
+                }
+                break;
+#endif /* GPS_CFG_STATEMENT_GPGSV */
+            default: break;
         }
         return 1;
     }
@@ -134,64 +384,81 @@ parse_term(gps_t* gh) {
     } else if (gh->p.stat == STAT_GGA) {        /* Process GPGGA statement */
         switch (gh->p.term_num) {
             case 1:                             /* Process UTC time */
-                gh->p.data.gga.hours = 10 * CTN(gh->p.term_str[0]) + CTN(gh->p.term_str[1]);
-                gh->p.data.gga.minutes = 10 * CTN(gh->p.term_str[2]) + CTN(gh->p.term_str[3]);
-                gh->p.data.gga.seconds = 10 * CTN(gh->p.term_str[4]) + CTN(gh->p.term_str[5]);
+                parse_tod(gh);
                 break;
             case 2:                             /* Latitude */
-                gh->p.data.gga.latitude = parse_lat_long(gh);   /* Parse latitude */
+                r->gga.latitude = parse_lat_long(gh);   /* Parse latitude */
                 break;
             case 3:                             /* Latitude north/south information */
                 if (gh->p.term_str[0] == 'S' || gh->p.term_str[0] == 's') {
-                    gh->p.data.gga.latitude = -gh->p.data.gga.latitude;
+                    r->gga.latitude = -r->gga.latitude;
                 }
                 break;
             case 4:                             /* Longitude */
-                gh->p.data.gga.longitude = parse_lat_long(gh);  /* Parse longitude */
+                r->gga.longitude = parse_lat_long(gh);  /* Parse longitude */
                 break;
             case 5:                             /* Longitude east/west information */
                 if (gh->p.term_str[0] == 'W' || gh->p.term_str[0] == 'w') {
-                    gh->p.data.gga.longitude = -gh->p.data.gga.longitude;
+                    r->gga.longitude = -r->gga.longitude;
                 }
                 break;
             case 6:                             /* Fix status */
-                gh->p.data.gga.fix = (uint8_t)parse_number(gh, NULL);
+                r->gga.fix = (uint8_t)parse_number(gh, NULL);
                 break;
             case 7:                             /* Satellites in use */
-                gh->p.data.gga.sats_in_use = (uint8_t)parse_number(gh, NULL);
+                r->gga.sats_in_use = (uint8_t)parse_number(gh, NULL);
+                break;
+            case 8:                             /* Horizontal dilution of precision */
+                r->gga.hdop = parse_float_number(gh, NULL);
                 break;
             case 9:                             /* Altitude */
-                gh->p.data.gga.altitude = parse_float_number(gh, NULL);
+                r->gga.altitude = parse_float_number(gh, NULL);
                 break;
             case 11:                            /* Altitude above ellipsoid */
-                gh->p.data.gga.geo_sep = parse_float_number(gh, NULL);
+                r->gga.geo_sep = parse_float_number(gh, NULL);
                 break;
             default: break;
         }
 #endif /* GPS_CFG_STATEMENT_GPGGA */
+#if GPS_CFG_STATEMENT_GPGSV
+    } else if (gh->p.stat == STAT_GSV) {        /* Process GPGSV statement */
+        if (gh->p.term_num == 3) {              /* Satellites in view, same in all statements of group */
+            gh->p.in_view = (uint8_t)parse_number(gh, NULL);
+        }
+#endif /* GPS_CFG_STATEMENT_GPGSV */
 #if GPS_CFG_STATEMENT_GPRMC
       } else if (gh->p.stat == STAT_RMC) {        /* Process GPRMC statement */
               switch (gh->p.term_num) {
+                  case 1:                             /* Process UTC time, reference for date */
+                      parse_tod(gh);
+                      break;
                   case 2:                             /* Process valid status */
-                      gh->p.data.rmc.is_valid = (gh->p.term_str[0] == 'A');
+                      r->rmc.is_valid = (gh->p.term_str[0] == 'A');
                       break;
                   case 7:                             /* Process ground speed in knots */
-                      gh->p.data.rmc.speed = parse_float_number(gh, NULL);
+                      r->rmc.speed = parse_float_number(gh, NULL);
                       break;
                   case 8:                             /* Process true ground coarse */
-                      gh->p.data.rmc.coarse = parse_float_number(gh, NULL);
+                      r->rmc.coarse = parse_float_number(gh, NULL);
                       break;
-                  case 9:                             /* Process date */
-                      gh->p.data.rmc.date = (uint8_t)(10 * CTN(gh->p.term_str[0]) + CTN(gh->p.term_str[1]));
-                      gh->p.data.rmc.month = (uint8_t)(10 * CTN(gh->p.term_str[2]) + CTN(gh->p.term_str[3]));
-                      gh->p.data.rmc.year = (uint8_t)(10 * CTN(gh->p.term_str[4]) + CTN(gh->p.term_str[5]));
+                  case 9: {                           /* Process date, exactly `ddmmyy` or it stays unknown */
+                      const char* t = gh->p.term_str;
+                      uint8_t i;
+
+                      for (i = 0; i < 6 && CIN(t[i]); i++) {}
+                      if (i == 6 && gh->p.term_pos == 6) {
+                          r->rmc.date = (uint8_t)(10 * CTN(t[0]) + CTN(t[1]));
+                          r->rmc.month = (uint8_t)(10 * CTN(t[2]) + CTN(t[3]));
+                          r->rmc.year = (uint8_t)(10 * CTN(t[4]) + CTN(t[5]));
+                      }
                       break;
+                  }
                   case 10:                            /* Process magnetic variation */
-                      gh->p.data.rmc.variation = parse_float_number(gh, NULL);
+                      r->rmc.variation = parse_float_number(gh, NULL);
                       break;
                   case 11:                            /* Process magnetic variation east/west */
                       if (gh->p.term_str[0] == 'W' || gh->p.term_str[0] == 'w') {
-                          gh->p.data.rmc.variation = -gh->p.data.rmc.variation;
+                          r->rmc.variation = -r->rmc.variation;
                       }
                       break;
                   default: break;
@@ -202,7 +469,7 @@ parse_term(gps_t* gh) {
 }
 
 /**
- * \brief           Copy temporary memory to user memory
+ * \brief           Copy temporary memory to user memory, with time and receive times of statement
  * \param[in]       gh: GPS handle
  * \return          `1` on success, `0` otherwise
  */
@@ -211,30 +478,230 @@ copy_from_tmp_memory(gps_t* gh) {
     if (0) {
 #if GPS_CFG_STATEMENT_GPGGA
     } else if (gh->p.stat == STAT_GGA) {
-        gh->latitude = gh->p.data.gga.latitude;
-        gh->longitude = gh->p.data.gga.longitude;
-        gh->altitude = gh->p.data.gga.altitude;
-        gh->geo_sep = gh->p.data.gga.geo_sep;
-        gh->sats_in_use = gh->p.data.gga.sats_in_use;
-        gh->fix = gh->p.data.gga.fix;
-        gh->hours = gh->p.data.gga.hours;
-        gh->minutes = gh->p.data.gga.minutes;
-        gh->seconds = gh->p.data.gga.seconds;
+        uint32_t sec = gh->p.timed ? gh->p.tod / 1000U : 0;
+
+        GGA(gh, epoch) = get_epoch(gh);
+        GGA(gh, timed) = gh->p.timed;
+        GGA(gh, dated) = gh->p.timed && gh->cal.dated;
+        GGA(gh, latitude) = gh->tmp.gga.latitude;
+        GGA(gh, longitude) = gh->tmp.gga.longitude;
+        GGA(gh, altitude) = gh->tmp.gga.altitude;
+        GGA(gh, geo_sep) = gh->tmp.gga.geo_sep;
+        GGA(gh, hdop) = gh->tmp.gga.hdop;
+#if GPS_CFG_PROTOCOL_UBX
+        GGA(gh, pdop) = gh->tmp.gga.pdop;
+#endif /* GPS_CFG_PROTOCOL_UBX */
+        GGA(gh, sats_in_use) = gh->tmp.gga.sats_in_use;
+        GGA(gh, fix) = gh->tmp.gga.fix;
+        GGA(gh, hours) = (uint8_t)(sec / 3600U);
+        GGA(gh, minutes) = (uint8_t)(sec / 60U % 60U);
+        GGA(gh, seconds) = (uint8_t)(sec % 60U);
+#if GPS_CFG_RX_TIMESTAMP
+#if GPS_CFG_COMPACT
+        gh->gga.rx_first = gh->p.rx_first;
+        gh->gga.rx_last = gh->p.rx_now;
+#else
+        gh->gga_rx_first = gh->p.rx_first;
+        gh->gga_rx_last = gh->p.rx_now;
+#endif /* GPS_CFG_COMPACT */
+#endif /* GPS_CFG_RX_TIMESTAMP */
 #endif /* GPS_CFG_STATEMENT_GPGGA */
 #if GPS_CFG_STATEMENT_GPRMC
     } else if (gh->p.stat == STAT_RMC) {
-        gh->coarse = gh->p.data.rmc.coarse;
-        gh->is_valid = gh->p.data.rmc.is_valid;
-        gh->speed = gh->p.data.rmc.speed;
-        gh->variation = gh->p.data.rmc.variation;
-        gh->date = gh->p.data.rmc.date;
-        gh->month = gh->p.data.rmc.month;
-        gh->year = gh->p.data.rmc.year;
+        set_date(gh, gh->tmp.rmc.date, gh->tmp.rmc.month, gh->tmp.rmc.year);
+        RMC(gh, coarse) = gh->tmp.rmc.coarse;
+        RMC(gh, is_valid) = gh->tmp.rmc.is_valid;
+        RMC(gh, speed) = gh->tmp.rmc.speed;
+        RMC(gh, variation) = gh->tmp.rmc.variation;
+        RMC(gh, date) = gh->tmp.rmc.date;
+        RMC(gh, month) = gh->tmp.rmc.month;
+        RMC(gh, year) = gh->tmp.rmc.year;
+#if GPS_CFG_RX_TIMESTAMP
+#if GPS_CFG_COMPACT
+        gh->rmc.rx_first = gh->p.rx_first;
+        gh->rmc.rx_last = gh->p.rx_now;
+#else
+        gh->rmc_rx_first = gh->p.rx_first;
+        gh->rmc_rx_last = gh->p.rx_now;
+#endif /* GPS_CFG_COMPACT */
+#endif /* GPS_CFG_RX_TIMESTAMP */
 #endif /* GPS_CFG_STATEMENT_GPRMC */
+#if GPS_CFG_STATEMENT_GPGSV
+    } else if (gh->p.stat == STAT_GSV) {
+        uint8_t i, total = 0;
+
+        gh->sats_in_view[gh->p.talker] = gh->p.in_view;
+        for (i = 0; i < GPS_SYSTEM_COUNT; i++) {
+            total += gh->sats_in_view[i];
+        }
+        gh->sats_in_view_total = total;
+#endif /* GPS_CFG_STATEMENT_GPGSV */
     }
     return 1;
 }
 
+/**
+ * \brief           Publish statement from staging area
+ * \param[in]       gh: GPS handle
+ */
+static void
+publish(gps_t* gh) {
+    copy_from_tmp_memory(gh);                   /* Copy memory from temporary to user memory */
+    STATS_INC(gh, published);
+}
+
+#if GPS_CFG_PROTOCOL_UBX
+/**
+ * \brief           Decode `NAV-PVT` payload byte, values are taken when their last byte arrives
+ *
+ *                  Position and time go to staging record as `GGA`, velocity and date
+ *                  are kept aside and published as `RMC` afterwards
+ * \param[in]       gh: GPS handle
+ * \param[in]       ch: Payload byte, already in `acc`
+ */
+static void
+ubx_nav_pvt(gps_t* gh, uint8_t ch) {
+    gps_stage_t* r = &gh->tmp;
+    uint32_t acc = gh->p.ubx.acc;
+
+    switch (gh->p.ubx.idx) {
+        case 5: gh->p.ubx.year = (uint8_t)((acc >> 16) % 100); break;  /* U2 year */
+        case 6: gh->p.ubx.month = ch; break;
+        case 7: gh->p.ubx.date = ch; break;
+        case 8: gh->p.ubx.hours = ch; break;
+        case 9: gh->p.ubx.minutes = ch; break;
+        case 10: gh->p.ubx.seconds = ch; break;
+        case 11: gh->p.ubx.valid = ch; break;   /* Bit 0 validDate, bit 1 validTime */
+        case 19: {                              /* I4 nano, correction of seconds, may be negative */
+            int32_t ms = (int32_t)acc / 1000000L;
+            uint32_t sec = ((uint32_t)gh->p.ubx.hours * 60 + gh->p.ubx.minutes) * 60 + gh->p.ubx.seconds;
+
+            if (ms < 0 && sec > 0) {            /* Time fields were rounded up */
+                sec--;
+                ms += 1000;
+            }
+            gh->p.tod = sec * 1000UL + (ms < 0 ? 0 : (uint32_t)ms);
+            gh->p.timed = (gh->p.ubx.valid & 0x02) != 0;  /* Time fields are not resolved yet otherwise */
+            break;
+        }
+        case 21: gh->p.ubx.flags = ch; break;   /* Bit 0 gnssFixOK, bit 1 diffSoln */
+        case 23: r->gga.sats_in_use = ch; break;
+        case 27: r->gga.longitude = FLT((int32_t)acc) * FLT(1e-7); break;
+        case 31: r->gga.latitude = FLT((int32_t)acc) * FLT(1e-7); break;
+        case 35: gh->p.ubx.height = (int32_t)acc; break;
+        case 39:                                /* Height above mean sea level */
+            r->gga.altitude = (gps_aux_float_t)((int32_t)acc * 0.001);
+            r->gga.geo_sep = (gps_aux_float_t)((gh->p.ubx.height - (int32_t)acc) * 0.001);
+            break;
+        case 63: gh->p.ubx.speed = (int32_t)acc; break;
+        case 67: gh->p.ubx.heading = (int32_t)acc; break;
+        case 77: r->gga.pdop = (gps_aux_float_t)((acc >> 16) * 1e-2); break; /* U2 pDOP, no HDOP in packet */
+        case 89: gh->p.ubx.mag_dec = (int16_t)(acc >> 16); break;
+        default: break;
+    }
+}
+
+/**
+ * \brief           Publish decoded `NAV-PVT` packet as `GGA` and `RMC` values
+ * \param[in]       gh: GPS handle
+ */
+static void
+ubx_publish(gps_t* gh) {
+    uint8_t ok = (gh->p.ubx.flags & 0x01) != 0;
+
+    gh->tmp.gga.fix = ok ? ((gh->p.ubx.flags & 0x02) ? 2 : 1) : 0;
+    if (gh->p.ubx.valid & 0x01) {               /* Date of packet applies to its own GGA epoch */
+        set_date(gh, gh->p.ubx.date, gh->p.ubx.month, gh->p.ubx.year);
+    }
+    gh->p.stat = STAT_GGA;
+    publish(gh);
+
+    memset(&gh->tmp, 0x00, sizeof(gh->tmp));    /* Staging area is free again after GGA was published */
+    gh->tmp.rmc.speed = (gps_aux_float_t)(gh->p.ubx.speed * MM_S_TO_KNOTS);
+    gh->tmp.rmc.coarse = (gps_aux_float_t)(gh->p.ubx.heading * 1e-5);
+    gh->tmp.rmc.variation = (gps_aux_float_t)(gh->p.ubx.mag_dec * 1e-2);
+    if (gh->p.ubx.valid & 0x01) {               /* Date stays `0` until it is resolved */
+        gh->tmp.rmc.date = gh->p.ubx.date;
+        gh->tmp.rmc.month = gh->p.ubx.month;
+        gh->tmp.rmc.year = gh->p.ubx.year;
+    }
+    gh->tmp.rmc.is_valid = ok;
+    gh->p.stat = STAT_RMC;
+    publish(gh);
+
+    gh->p.stat = STAT_UNKNOWN;                  /* Nothing to publish on stray end of line */
+}
+
+/**
+ * \brief           Process byte of UBX frame
+ * \param[in]       gh: GPS handle
+ * \param[in]       ch: Received byte
+ * \return          `1` when byte was consumed by decoder, `0` when it belongs to NMEA stream
+ */
+static uint8_t
+ubx_process(gps_t* gh, uint8_t ch) {
+    uint8_t st = gh->p.ubx.state;
+
+    if (st == UBX_IDLE) {
+        if (ch != UBX_SYNC1) {
+            return 0;
+        }
+#if GPS_CFG_RX_TIMESTAMP
+        gh->p.rx_first = gh->p.rx_now;
+#endif /* GPS_CFG_RX_TIMESTAMP */
+        gh->p.ubx.state = UBX_S_SYNC2;
+        return 1;
+    }
+    if (st == UBX_S_SYNC2) {
+        if (ch != UBX_SYNC2) {                  /* False sync, byte goes to NMEA parser */
+            gh->p.ubx.state = UBX_IDLE;
+            return 0;
+        }
+        memset(&gh->p.ubx, 0x00, sizeof(gh->p.ubx));
+        memset(&gh->tmp, 0x00, sizeof(gh->tmp));
+        gh->p.stat = STAT_UNKNOWN;
+        gh->p.sync = 0;                         /* NMEA sentence interrupted by frame is lost */
+        gh->p.ubx.state = UBX_S_CLASS;
+        return 1;
+    }
+    if (st < UBX_S_CK_A) {                      /* Checksum covers class, ID, length and payload */
+        gh->p.ubx.ck_a += ch;
+        gh->p.ubx.ck_b += gh->p.ubx.ck_a;
+    }
+    switch (st) {
+        case UBX_S_CLASS: gh->p.ubx.cls = ch; gh->p.ubx.state = UBX_S_ID; break;
+        case UBX_S_ID: gh->p.ubx.id = ch; gh->p.ubx.state = UBX_S_LEN1; break;
+        case UBX_S_LEN1: gh->p.ubx.len = ch; gh->p.ubx.state = UBX_S_LEN2; break;
+        case UBX_S_LEN2:
+            gh->p.ubx.len |= (uint16_t)ch << 8;
+            gh->p.ubx.state = gh->p.ubx.len > UBX_MAX_LEN ? UBX_IDLE : (gh->p.ubx.len ? UBX_S_PAYLOAD : UBX_S_CK_A);
+            break;
+        case UBX_S_PAYLOAD:
+            gh->p.ubx.acc = (gh->p.ubx.acc >> 8) | ((uint32_t)ch << 24);
+            if (gh->p.ubx.cls == UBX_NAV && gh->p.ubx.id == UBX_NAV_PVT) {
+                ubx_nav_pvt(gh, ch);
+            }
+            if (++gh->p.ubx.idx >= gh->p.ubx.len) {
+                gh->p.ubx.state = UBX_S_CK_A;
+            }
+            break;
+        case UBX_S_CK_A:
+            gh->p.ubx.state = ch == gh->p.ubx.ck_a ? UBX_S_CK_B : UBX_IDLE;
+            break;
+        case UBX_S_CK_B:
+            if (ch == gh->p.ubx.ck_b && gh->p.ubx.cls == UBX_NAV
+                && gh->p.ubx.id == UBX_NAV_PVT && gh->p.ubx.len >= 92) {
+                ubx_publish(gh);
+            }
+            gh->p.ubx.state = UBX_IDLE;
+            break;
+        default:
+            gh->p.ubx.state = UBX_IDLE;
+            break;
+    }
+    return 1;
+}
+#endif /* GPS_CFG_PROTOCOL_UBX */
 
 /**
  * \brief           Init GPS handle
@@ -248,8 +715,32 @@ gps_init(gps_t* gh) {
 
 }
 
+/**
+ * \brief           Add bytes to length of sentence being received
+ * \param[in]       gh: GPS handle
+ * \param[in]       n: Number of bytes since last counted byte
+ * \return          `1` when sentence is not longer than \ref GPS_CFG_NMEA_MAX_LEN, `0` when it was discarded
+ */
+static uint8_t
+len_add(gps_t* gh, size_t n) {
+    n += gh->p.len;
+    if (n > GPS_CFG_NMEA_MAX_LEN) {
+        DISCARD(gh, length_errors);
+        return 0;
+    }
+    gh->p.len = (uint8_t)n;
+    return 1;
+}
+
 /**
  * \brief           Process NMEA data from GPS receiver
+ *
+ *                  Sentence is published only when it is not longer than \ref GPS_CFG_NMEA_MAX_LEN,
+ *                  has only printable characters, `*` followed by exactly two hexadecimal digits
+ *                  and `\r`, matching CRC and all fields library reads. On first violation
+ *                  sentence is discarded and bytes are skipped until next `$`.
+ *                  Sentences of types not parsed are skipped right after their type.
+ *                  Common term characters take short path, length is checked at term delimiters
  * \param[in]       gh: GPS handle structure
  * \param[in]       data: Received data
  * \param[in]       len: Number of bytes to process
@@ -258,32 +749,224 @@ gps_init(gps_t* gh) {
 uint8_t
 gps_process(gps_t* gh, const void* data, size_t len){
     const uint8_t* d = data;
+    const uint8_t* end = d + len;
+    const uint8_t* t = d;                               /* First byte not counted in sentence length yet */
+    GPS_PROF_BEGIN(GPS_PROF_PROCESS);
 
-    while (len--) {                                     /* Process all bytes */
-        if (*d == '$'){                                 /* Check for beginning of NMEA line */
-                    memset(&gh->p, 0x00, sizeof(gh->p));/* Reset private memory */
-                    TERM_ADD(gh, *d);                   /* Add character to term */
-        }else if (*d == ',') {                         /* Term separator character */
-                parse_term(gh);                        /* Parse term we have currently in memory */
-                CRC_ADD(gh, *d);                       /* Add character to CRC computation */
-                TERM_NEXT(gh);                         /* Start with next term */
-        }else if (*d == '*') {                         /* Start indicates end of data for CRC computation */
-            parse_term(gh);                            /* Parse term we have currently in memory */
-            gh->p.star = 1;                            /* STAR detected */
-            TERM_NEXT(gh);                             /* Start with next term */
-        }else if (*d == '\r') {
-            if (check_crc(gh)){                        /* Check for CRC result */
+    while (d < end) {                                   /* Process all bytes */
+#if GPS_CFG_PROTOCOL_UBX
+        if ((gh->p.ubx.state != UBX_IDLE || *d == UBX_SYNC1)
+            && ubx_process(gh, *d)) {                   /* Byte is part of binary frame */
+            d++;
+            continue;
+        }
+#endif /* GPS_CFG_PROTOCOL_UBX */
+        if (!gh->p.sync && *d != '$') {                 /* Discarding until next sentence */
+            d++;
+            continue;
+        }
+        if (*d > '*' && *d <= '~' && *d != ',' && !gh->p.star) {
+            do {                                        /* Printable term characters, no delimiter */
+                CRC_ADD(gh, *d);                        /* Add to CRC */
+                TERM_ADD(gh, *d);                       /* Add character to term */
+            } while (++d < end && *d > '*' && *d <= '~' && *d != ',');
+            continue;
+        }
+        if (*d == '$') {                                /* Check for beginning of NMEA line */
+#if GPS_CFG_RX_TIMESTAMP
+            gps_tick_t now = gh->p.rx_now;              /* Keep receive time over reset */
+#endif /* GPS_CFG_RX_TIMESTAMP */
+            if (gh->p.sync && len_add(gh, (size_t)(d - t))) {  /* Previous sentence was cut */
+                STATS_INC(gh, format_errors);
+            }
+            memset(&gh->p, 0x00, sizeof(gh->p));        /* Reset private memory */
+            memset(&gh->tmp, 0x00, sizeof(gh->tmp));    /* Reset staging area */
+#if GPS_CFG_RX_TIMESTAMP
+            gh->p.rx_now = gh->p.rx_first = now;
+#endif /* GPS_CFG_RX_TIMESTAMP */
+            gh->p.sync = 1;
+            gh->p.len = 1;
+            TERM_ADD(gh, *d);                           /* Add character to term */
+        } else if (!len_add(gh, (size_t)(d + 1 - t))) {
+            /* Too long, skipped until next `$` */
+        } else if (*d == ',') {                         /* Term separator character */
+            if (gh->p.star) {
+                DISCARD(gh, format_errors);
+            } else {
+                GPS_PROF_BEGIN(GPS_PROF_PARSE_TERM);
+                parse_term(gh);                         /* Parse term we have currently in memory */
+                GPS_PROF_END(GPS_PROF_PARSE_TERM);
+                CRC_ADD(gh, *d);                        /* Add character to CRC computation */
+                if (gh->p.term_num == 0 && gh->p.stat == STAT_UNKNOWN) {
+                    gh->p.sync = 0;                     /* Not parsed, skip rest of sentence */
+                    STATS_INC(gh, ignored);
+                }
+                TERM_NEXT(gh);                          /* Start with next term */
+            }
+        } else if (*d == '*') {                         /* Start indicates end of data for CRC computation */
+            if (gh->p.star) {
+                DISCARD(gh, format_errors);
+            } else {
+                GPS_PROF_BEGIN(GPS_PROF_PARSE_TERM);
+                parse_term(gh);                         /* Parse term we have currently in memory */
+                GPS_PROF_END(GPS_PROF_PARSE_TERM);
+                gh->p.star = 1;                         /* STAR detected */
+                TERM_NEXT(gh);                          /* Start with next term */
+            }
+        } else if (*d == '\r') {
+            if (!gh->p.star || gh->p.term_pos != 2) {   /* Missing star or CRC digits */
+                STATS_INC(gh, format_errors);
+            } else if (!check_crc(gh)) {                /* Check for CRC result */
+                STATS_INC(gh, crc_errors);
+            } else if (!check_fields(gh)) {
+                STATS_INC(gh, format_errors);
+            } else {
                 /* CRC is OK, in theory we can copy data from statements to user data */
-                copy_from_tmp_memory(gh);               /* Copy memory from temporary to user memory */
+                publish(gh);
             }
-        }else {
-            if (!gh->p.star){                  /* Add to CRC only if star not yet detected */
-                        CRC_ADD(gh, *d);                /* Add to CRC */
-                    }
-                TERM_ADD(gh, *d);                   /* Add character to term */
+            gh->p.sync = 0;                             /* Nothing more to publish until next `$` */
+        } else if (*d < ' ' || *d > '~') {              /* Line break or binary garbage inside sentence */
+            DISCARD(gh, format_errors);
+        } else if (gh->p.star) {                        /* CRC digits */
+            if (!CHX(*d) || gh->p.term_pos >= 2) {
+                DISCARD(gh, format_errors);
+            } else {
+                TERM_ADD(gh, *d);
             }
-            d++;                                    /* Process next character */
+        } else {
+            CRC_ADD(gh, *d);                            /* Rare printable characters, space to `)` */
+            TERM_ADD(gh, *d);
         }
-        return 1;
+        t = ++d;                                        /* Process next character */
+    }
+    if (gh->p.sync && t < end) {                        /* Count rest of unfinished term */
+        len_add(gh, (size_t)(end - t));
+    }
+    GPS_PROF_END(GPS_PROF_PROCESS);
+    return 1;
+}
+
+/**
+ * \brief           Get snapshot of last valid values
+ * \param[in]       gh: GPS handle structure
+ * \param[out]      fix: Output snapshot
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gps_get_fix(const gps_t* gh, gps_fix_t* fix) {
+    if (gh == NULL || fix == NULL) {
+        return 0;
+    }
+#if GPS_CFG_COMPACT
+    fix->gga = *gps_gga(gh);
+    fix->rmc = *gps_rmc(gh);
+#else
+    fix->gga.latitude = gh->latitude;
+    fix->gga.longitude = gh->longitude;
+    fix->gga.altitude = gh->altitude;
+    fix->gga.geo_sep = gh->geo_sep;
+    fix->gga.hdop = gh->hdop;
+#if GPS_CFG_PROTOCOL_UBX
+    fix->gga.pdop = gh->pdop;
+#endif /* GPS_CFG_PROTOCOL_UBX */
+    fix->gga.fix = gh->fix;
+    fix->gga.sats_in_use = gh->sats_in_use;
+    fix->gga.hours = gh->hours;
+    fix->gga.minutes = gh->minutes;
+    fix->gga.seconds = gh->seconds;
+    fix->gga.epoch = gh->epoch;
+    fix->gga.timed = gh->timed;
+    fix->gga.dated = gh->dated;
+    fix->rmc.speed = gh->speed;
+    fix->rmc.coarse = gh->coarse;
+    fix->rmc.variation = gh->variation;
+    fix->rmc.is_valid = gh->is_valid;
+    fix->rmc.date = gh->date;
+    fix->rmc.month = gh->month;
+    fix->rmc.year = gh->year;
+#if GPS_CFG_RX_TIMESTAMP
+    fix->gga.rx_first = gh->gga_rx_first;
+    fix->gga.rx_last = gh->gga_rx_last;
+    fix->rmc.rx_first = gh->rmc_rx_first;
+    fix->rmc.rx_last = gh->rmc_rx_last;
+#endif /* GPS_CFG_RX_TIMESTAMP */
+#endif /* GPS_CFG_COMPACT */
+    return 1;
+}
+
+/**
+ * \brief           Set receive time of next byte passed to \ref gps_process
+ *
+ *                  Time is latched at `$` and `\r`, so it only has to be set before those bytes
+ * \param[in]       gh: GPS handle structure
+ * \param[in]       ts: Receive time in units of ticks
+ */
+void
+gps_set_rx_time(gps_t* gh, gps_tick_t ts) {
+#if GPS_CFG_RX_TIMESTAMP
+    gh->p.rx_now = ts;
+#else
+    (void)gh;
+    (void)ts;
+#endif /* GPS_CFG_RX_TIMESTAMP */
+}
+
+/**
+ * \brief           Get counters of published and rejected sentences
+ * \param[in]       gh: GPS handle structure
+ * \param[out]      stats: Output counters
+ * \return          `1` on success, `0` otherwise or when \ref GPS_CFG_STATS is disabled
+ */
+uint8_t
+gps_get_stats(const gps_t* gh, gps_stats_t* stats) {
+#if GPS_CFG_STATS
+    if (gh == NULL || stats == NULL) {
+        return 0;
+    }
+    *stats = gh->stats;
+    return 1;
+#else
+    (void)gh;
+    (void)stats;
+    return 0;
+#endif /* GPS_CFG_STATS */
 }
 
+/**
+ * \brief           Process all data waiting in ring buffer
+ *
+ *                  Data are processed in blocks. When buffer has receive time marks,
+ *                  blocks are split at marked bytes to pass their receive time to parser
+ * \param[in]       gh: GPS handle structure
+ * \param[in]       buff: Ring buffer with received data
+ * \return          Number of bytes processed
+ */
+size_t
+gps_process_buff(gps_t* gh, gps_buff_t* buff) {
+    uint8_t block[32];
+    size_t n, total = 0;
+#if GPS_CFG_RX_TIMESTAMP
+    size_t off;
+    gps_tick_t ts;
+#endif /* GPS_CFG_RX_TIMESTAMP */
+
+    for (;;) {
+        n = sizeof(block);
+#if GPS_CFG_RX_TIMESTAMP
+        if (buff_mark_peek(buff, &off, &ts)) {
+            if (off == 0) {                     /* Marked byte is next */
+                gps_set_rx_time(gh, ts);
+                off = 1;
+            }
+            n = off < n ? off : n;
+        }
+#endif /* GPS_CFG_RX_TIMESTAMP */
+        n = buff_read(buff, block, n);
+        if (n == 0) {
+            break;
+        }
+        gps_process(gh, block, n);
+        total += n;
+    }
+    return total;
+}
@@ -11,7 +11,9 @@
 #include <stdint.h>
 #include <stddef.h>
 
-
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
 
 /**
  * \brief           Enables `1` or disables `0` `GGA` statement parsing.
@@ -19,6 +21,7 @@
  * \note            This statement must be enabled to parse:
  *                      - Latitude, Longitude, Altitude
  *                      - Number of satellites in use, fix (no fix, GPS, DGPS), UTC time
+ *                      - Horizontal dilution of precision
  */
 #ifndef GPS_CFG_STATEMENT_GPGGA
 #define GPS_CFG_STATEMENT_GPGGA             1
@@ -37,71 +40,361 @@
 #define GPS_CFG_STATEMENT_GPRMC             1
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` `GSV` statement parsing.
+ *
+ * \note            This statement must be enabled to parse:
+ *                      - Number of satellites in view of each constellation
+ */
+#ifndef GPS_CFG_STATEMENT_GPGSV
+#define GPS_CFG_STATEMENT_GPGSV             0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` u-blox binary protocol (UBX) parsing.
+ *
+ * \note            Protocol is detected by sync bytes, so NMEA and UBX may be mixed on one stream.
+ *                  `NAV-PVT` packet updates the same values as both `GGA` and `RMC` statements
+ */
+#ifndef GPS_CFG_PROTOCOL_UBX
+#define GPS_CFG_PROTOCOL_UBX                0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` compact memory layout.
+ *
+ * \note            When enabled, published values are kept as one `GGA` and one `RMC` record
+ *                  and secondary values (altitude, speed, ...) are stored as `float`.
+ *                  Terms are parsed into staging area shared by all statement types,
+ *                  which is copied to published record once the CRC matches.
+ *                  Compact handle is always smaller than flat one, with default options
+ *                  it is not larger than handle of library before layout options (136 bytes).
+ *
+ *                  Flat fields such as `gh->latitude` are not available in this mode,
+ *                  use \ref gps_gga, \ref gps_rmc or \ref gps_get_fix instead.
+ */
+#ifndef GPS_CFG_COMPACT
+#define GPS_CFG_COMPACT                     1
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` receive timestamps.
+ *
+ * \note            When enabled, every published statement carries receive time
+ *                  of its first (`$`) and last (`\r`) byte. Times are supplied
+ *                  with \ref gps_set_rx_time or taken from marks of the ring buffer
+ *                  when data are processed with \ref gps_process_buff
+ */
+#ifndef GPS_CFG_RX_TIMESTAMP
+#define GPS_CFG_RX_TIMESTAMP                0
+#endif
+
+/**
+ * \brief           Maximal length of NMEA sentence from `$` to `\r`, up to `255`.
+ *
+ * \note            Longer sentences are considered corrupted and discarded.
+ *                  Standard limit is `82` characters including `\r\n`
+ */
+#ifndef GPS_CFG_NMEA_MAX_LEN
+#define GPS_CFG_NMEA_MAX_LEN                82
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` counters of published and rejected sentences.
+ *                  Counters are read with \ref gps_get_stats
+ */
+#ifndef GPS_CFG_STATS
+#define GPS_CFG_STATS                       0
+#endif
+
+/**
+ * \brief           Size of cache line in units of bytes.
+ *                  Fields read by application on every loop must fit in first line.
+ */
+#ifndef GPS_CFG_CACHE_LINE
+#define GPS_CFG_CACHE_LINE                  64
+#endif
+
+/**
+ * \brief           Type used for timestamps in units of clock ticks.
+ *                  Differences are computed with wrap-around, so `32`-bit is enough
+ *                  for intervals shorter than one counter period
+ */
+#ifndef GPS_CFG_TICK_TYPE
+#define GPS_CFG_TICK_TYPE                   uint32_t
+#endif
+
+/**
+ * \brief           Compile time assertion, usable in C89 and C99
+ * \param[in]       expr: Expression which must be true
+ * \param[in]       name: Unique identifier used to name the check
+ */
+#define GPS_STATIC_ASSERT(expr, name)       typedef char gps_static_assert_ ## name[(expr) ? 1 : -1]
+
 /**
  * \brief           GPS float definition `float`
  *
  */
 typedef double gps_float_t;
 
+/**
+ * \brief           Timestamp in units of clock ticks, see \ref GPS_CFG_TICK_TYPE
+ */
+typedef GPS_CFG_TICK_TYPE gps_tick_t;
+
+/**
+ * \brief           UTC time in units of microseconds since 1970-01-01
+ */
+typedef uint64_t gps_epoch_t;
+
+/**
+ * \brief           Epoch value never published by parser, marks missing epoch in state of consumers
+ */
+#define GPS_EPOCH_NONE                      ((gps_epoch_t)-1)
+
+/**
+ * \brief           Float type for secondary values (altitude, speed, coarse, ...)
+ *                  which do not need double precision
+ */
+#if GPS_CFG_COMPACT
+typedef float gps_aux_float_t;
+#else
+typedef gps_float_t gps_aux_float_t;
+#endif /* GPS_CFG_COMPACT */
+
+/**
+ * \brief           Satellite system, decoded from talker ID of NMEA statement
+ */
+typedef enum {
+    GPS_SYSTEM_GPS = 0,                         /*!< GPS, talker `GP` */
+    GPS_SYSTEM_GLONASS,                         /*!< GLONASS, talker `GL` */
+    GPS_SYSTEM_GALILEO,                         /*!< Galileo, talker `GA` */
+    GPS_SYSTEM_BEIDOU,                          /*!< BeiDou, talker `GB` or `BD` */
+    GPS_SYSTEM_COUNT,                           /*!< Number of constellations */
+    GPS_SYSTEM_MULTI = GPS_SYSTEM_COUNT,        /*!< Combined solution of several constellations, talker `GN` */
+    GPS_SYSTEM_UNKNOWN                          /*!< Talker not supported */
+} gps_system_t;
+
+/**
+ * \brief           Values received in GPGGA statement
+ * \note            Doubles first, then bytes, to avoid padding
+ */
+typedef struct {
+    gps_float_t latitude;                       /*!< GPS latitude position in degrees */
+    gps_float_t longitude;                      /*!< GPS longitude position in degrees */
+    gps_epoch_t epoch;                          /*!< UTC time of fix with fractional seconds, valid when `timed` is set.
+                                                    Counts from 1970-01-01 when `dated` is set, from day `0` before */
+    gps_aux_float_t altitude;                   /*!< GPS altitude in meters */
+    gps_aux_float_t geo_sep;                    /*!< Geoid separation in units of meters */
+    gps_aux_float_t hdop;                       /*!< Horizontal dilution of precision, `0` when not reported */
+#if GPS_CFG_PROTOCOL_UBX
+    gps_aux_float_t pdop;                       /*!< Position dilution of precision of UBX `NAV-PVT`, `0` for NMEA */
+#endif /* GPS_CFG_PROTOCOL_UBX */
+#if GPS_CFG_RX_TIMESTAMP
+    gps_tick_t rx_first;                        /*!< Receive time of first byte of statement */
+    gps_tick_t rx_last;                         /*!< Receive time of last byte of statement */
+#endif /* GPS_CFG_RX_TIMESTAMP */
+    uint8_t fix;                                /*!< Type of current fix, `0` = Invalid, `1` = GPS fix, `2` = Differential GPS fix */
+    uint8_t sats_in_use;                        /*!< Number of satellites currently in use */
+    uint8_t hours;                              /*!< Current UTC hours */
+    uint8_t minutes;                            /*!< Current UTC minutes */
+    uint8_t seconds;                            /*!< Current UTC seconds */
+    uint8_t timed;                              /*!< Set when statement has time and `epoch` is valid, `epoch` is `0` otherwise */
+    uint8_t dated;                              /*!< Set when date of `epoch` is known from RMC or UBX, stays set afterwards */
+} gps_gga_t;
+
+/**
+ * \brief           Values received in GPRMC statement
+ */
+typedef struct {
+#if GPS_CFG_RX_TIMESTAMP
+    gps_tick_t rx_first;                        /*!< Receive time of first byte of statement */
+    gps_tick_t rx_last;                         /*!< Receive time of last byte of statement */
+#endif /* GPS_CFG_RX_TIMESTAMP */
+    gps_aux_float_t speed;                      /*!< Current spead over the ground in knots */
+    gps_aux_float_t coarse;                     /*!< Current coarse made good */
+    gps_aux_float_t variation;                  /*!< Current magnetic variation in degrees */
+    uint8_t is_valid;                           /*!< Status whether GPS status is valid or not */
+    uint8_t date;                               /*!< Current UTF date */
+    uint8_t month;                              /*!< Current UTF month */
+    uint8_t year;                               /*!< Current UTF year */
+} gps_rmc_t;
+
+/**
+ * \brief           Record holding values of one statement
+ */
+typedef union {
+    uint8_t dummy;                              /*!< Dummy byte */
+    gps_gga_t gga;                              /*!< GPGGA message */
+    gps_rmc_t rmc;                              /*!< GPRMC message */
+} gps_rec_t;
+
+/**
+ * \brief           Values of statement being parsed, private to library.
+ *                  Time is kept in private state and added on publish
+ */
+typedef union {
+    struct {
+        gps_float_t latitude;                   /*!< Latitude in units of degrees */
+        gps_float_t longitude;                  /*!< Longitude in units of degrees */
+        gps_aux_float_t altitude;               /*!< Altitude in units of meters */
+        gps_aux_float_t geo_sep;                /*!< Geoid separation in units of meters */
+        gps_aux_float_t hdop;                   /*!< Horizontal dilution of precision */
+#if GPS_CFG_PROTOCOL_UBX
+        gps_aux_float_t pdop;                   /*!< Position dilution of precision */
+#endif /* GPS_CFG_PROTOCOL_UBX */
+        uint8_t fix;                            /*!< Type of fix */
+        uint8_t sats_in_use;                    /*!< Number of satellites in use */
+    } gga;                                      /*!< GPGGA or UBX `NAV-PVT` values */
+    struct {
+        gps_aux_float_t speed;                  /*!< Ground speed in knots */
+        gps_aux_float_t coarse;                 /*!< Coarse made good */
+        gps_aux_float_t variation;              /*!< Magnetic variation in degrees */
+        uint8_t is_valid;                       /*!< GPS valid status */
+        uint8_t date;                           /*!< UTC date */
+        uint8_t month;                          /*!< UTC month */
+        uint8_t year;                           /*!< UTC year */
+    } rmc;                                      /*!< GPRMC values */
+} gps_stage_t;
+
+/**
+ * \brief           Snapshot of all published values, identical in both memory layouts
+ */
+typedef struct {
+    gps_gga_t gga;                              /*!< Last valid GPGGA values */
+    gps_rmc_t rmc;                              /*!< Last valid GPRMC values */
+} gps_fix_t;
+
+/**
+ * \brief           Counters of processed data
+ */
+typedef struct {
+    uint32_t published;                         /*!< Number of published records */
+    uint32_t ignored;                           /*!< Number of well-formed sentences of types not parsed */
+    uint32_t crc_errors;                        /*!< Number of sentences with wrong checksum */
+    uint32_t format_errors;                     /*!< Number of sentences cut by next `$`, without `*`,
+                                                    with invalid characters or checksum digits, or with too few fields */
+    uint32_t length_errors;                     /*!< Number of sentences longer than \ref GPS_CFG_NMEA_MAX_LEN */
+} gps_stats_t;
+
 /**
  *   GPS structure
  */
-typedef struct{
-
-        /* Information related to GPGGA statement */
-        gps_float_t latitude;                       /*!< Latitude in units of degrees */
-        gps_float_t longitude;                      /*!< Longitude in units of degrees */
-        gps_float_t altitude;                       /*!< Altitude in units of meters */
-        gps_float_t geo_sep;                        /*!< Geoid separation in units of meters */
-        uint8_t sats_in_use;                        /*!< Number of satellites in use */
-        uint8_t fix;                                /*!< Fix status. `0` = invalid, `1` = GPS fix, `2` = DGPS fix, `3` = PPS fix */
-        uint8_t hours;                              /*!< Hours in UTC */
-        uint8_t minutes;                            /*!< Minutes in UTC */
-        uint8_t seconds;                            /*!< Seconds in UTC */
-
-        /* Information related to GPRMC statement */
-          uint8_t is_valid;                           /*!< GPS valid status */
-          gps_float_t speed;                          /*!< Ground speed in knots */
-          gps_float_t coarse;                         /*!< Ground coarse */
-          gps_float_t variation;                      /*!< Magnetic variation */
-          uint8_t date;                               /*!< Fix date */
-          uint8_t month;                              /*!< Fix month */
-          uint8_t year;                               /*!< Fix year */
+typedef struct {
+#if !GPS_CFG_COMPACT
+    /* Hot data, read by application on every loop. Kept within first cache line */
+    gps_float_t latitude;                       /*!< Latitude in units of degrees */
+    gps_float_t longitude;                      /*!< Longitude in units of degrees */
+    gps_float_t altitude;                       /*!< Altitude in units of meters */
+    gps_float_t geo_sep;                        /*!< Geoid separation in units of meters */
+    gps_float_t speed;                          /*!< Ground speed in knots */
+    gps_float_t coarse;                         /*!< Ground coarse */
+    gps_float_t variation;                      /*!< Magnetic variation */
+    uint8_t fix;                                /*!< Fix status. `0` = invalid, `1` = GPS fix, `2` = DGPS fix, `3` = PPS fix */
+    uint8_t sats_in_use;                        /*!< Number of satellites in use */
+    uint8_t hours;                              /*!< Hours in UTC */
+    uint8_t minutes;                            /*!< Minutes in UTC */
+    uint8_t seconds;                            /*!< Seconds in UTC */
+    uint8_t is_valid;                           /*!< GPS valid status */
+    uint8_t date;                               /*!< Fix date */
+    uint8_t month;                              /*!< Fix month */
+    uint8_t year;                               /*!< Fix year */
+    uint8_t timed;                              /*!< Set when `epoch` is valid, see \ref gps_gga_t */
+    uint8_t dated;                              /*!< Set when `epoch` has date, see \ref gps_gga_t */
+#if GPS_CFG_RX_TIMESTAMP
+    gps_tick_t gga_rx_first;                    /*!< Receive time of first byte of last valid GGA statement */
+    gps_tick_t gga_rx_last;                     /*!< Receive time of last byte of last valid GGA statement */
+    gps_tick_t rmc_rx_first;                    /*!< Receive time of first byte of last valid RMC statement */
+    gps_tick_t rmc_rx_last;                     /*!< Receive time of last byte of last valid RMC statement */
+#endif /* GPS_CFG_RX_TIMESTAMP */
+    gps_float_t hdop;                           /*!< Horizontal dilution of precision */
+#if GPS_CFG_PROTOCOL_UBX
+    gps_aux_float_t pdop;                       /*!< Position dilution of precision, see \ref gps_gga_t */
+#endif /* GPS_CFG_PROTOCOL_UBX */
+    gps_epoch_t epoch;                          /*!< UTC time of fix, see \ref gps_gga_t */
+#else
+    gps_gga_t gga;                              /*!< Last valid GGA values, read with \ref gps_gga */
+    gps_rmc_t rmc;                              /*!< Last valid RMC values, read with \ref gps_rmc */
+#endif /* !GPS_CFG_COMPACT */
+    gps_stage_t tmp;                            /*!< Private staging area with data for statement being parsed */
 
     struct {
+#if GPS_CFG_PROTOCOL_UBX
+        struct {
+            uint32_t acc;                       /*!< Last 4 payload bytes, little endian */
+            int32_t height;                     /*!< Height above ellipsoid in units of mm */
+            int32_t speed;                      /*!< Ground speed in units of mm/s */
+            int32_t heading;                    /*!< Heading of motion in units of 1e-5 degrees */
+            uint16_t len;                       /*!< Payload length */
+            uint16_t idx;                       /*!< Index of next payload byte */
+            int16_t mag_dec;                    /*!< Magnetic declination in units of 1e-2 degrees */
+            uint8_t state;                      /*!< Frame decoder state, `0` when not in UBX frame */
+            uint8_t cls;                        /*!< Message class */
+            uint8_t id;                         /*!< Message ID */
+            uint8_t ck_a;                       /*!< Fletcher checksum, first byte */
+            uint8_t ck_b;                       /*!< Fletcher checksum, second byte */
+            uint8_t flags;                      /*!< NAV-PVT fix status flags */
+            uint8_t valid;                      /*!< NAV-PVT validity flags of date and time */
+            uint8_t year;                       /*!< UTC year since 2000 */
+            uint8_t month;                      /*!< UTC month */
+            uint8_t date;                       /*!< UTC day of month */
+            uint8_t hours;                      /*!< UTC hours */
+            uint8_t minutes;                    /*!< UTC minutes */
+            uint8_t seconds;                    /*!< UTC seconds, rounded */
+        } ubx;                                  /*!< UBX frame decoder, keeps raw values published as RMC after GGA */
+#endif /* GPS_CFG_PROTOCOL_UBX */
+#if GPS_CFG_RX_TIMESTAMP
+        gps_tick_t rx_now;                      /*!< Receive time of byte being processed */
+        gps_tick_t rx_first;                    /*!< Receive time of `$` of current statement */
+#endif /* GPS_CFG_RX_TIMESTAMP */
+        uint32_t tod;                           /*!< UTC time of day of statement in units of milliseconds */
         uint8_t stat;                           /*!< Statement index */
         char term_str[13];                      /*!< Current term in string format */
         uint8_t term_pos;                       /*!< Current index position in term */
         uint8_t term_num;                       /*!< Current term number */
         uint8_t star;                           /*!< Star detected flag */
         uint8_t crc_calc;                       /*!< Calculated CRC string */ // CRC = cyclic redundacy Checksum, used for checking integrity of data being transferred.
+        uint8_t sync;                           /*!< Set to `1` inside sentence which is valid so far, `0` while discarding until next `$` */
+        uint8_t len;                            /*!< Number of characters of sentence so far */
+        uint8_t talker;                         /*!< Satellite system of statement, member of \ref gps_system_t */
+        uint8_t timed;                          /*!< Set when statement carries valid time of day in `tod` */
+#if GPS_CFG_STATEMENT_GPGSV
+        uint8_t in_view;                        /*!< Satellites in view of GSV statement being parsed */
+#endif /* GPS_CFG_STATEMENT_GPGSV */
+    } p;                                        /*!< Structure with private data */
+
+#if GPS_CFG_STATEMENT_GPGSV
+    uint8_t sats_in_view[GPS_SYSTEM_COUNT];     /*!< Satellites in view per constellation, indexed by \ref gps_system_t.
+                                                    Value stays until next GSV statement of same constellation */
+    uint8_t sats_in_view_total;                 /*!< Satellites in view of all constellations */
+#endif /* GPS_CFG_STATEMENT_GPGSV */
+
+#if GPS_CFG_STATS
+    gps_stats_t stats;                          /*!< Counters of processed data, kept over sentences */
+#endif /* GPS_CFG_STATS */
+
+    struct {
+        uint32_t ref;                           /*!< Last known UTC time of day on `day` in units of milliseconds,
+                                                    valid when `timed` is set */
+        uint16_t day;                           /*!< Current UTC day, days since 1970-01-01 */
+        uint8_t timed;                          /*!< Set after first statement with time */
+        uint8_t dated;                          /*!< Set once date is known, `day` counts from `0` before */
+    } cal;                                      /*!< Calendar state for \ref gps_gga_t epoch, kept over sentences */
+} gps_t;
 
-        union{
-                uint8_t dummy;                      /*!< Dummy byte */
-                struct {
-                    gps_float_t latitude;           /*!< GPS latitude position in degrees */
-                    gps_float_t longitude;          /*!< GPS longitude position in degrees */
-                    gps_float_t altitude;           /*!< GPS altitude in meters */
-                    gps_float_t geo_sep;            /*!< Geoid separation in units of meters */
-                    uint8_t sats_in_use;            /*!< Number of satellites currently in use */
-                    uint8_t fix;                    /*!< Type of current fix, `0` = Invalid, `1` = GPS fix, `2` = Differential GPS fix */
-                    uint8_t hours;                  /*!< Current UTC hours */
-                    uint8_t minutes;                /*!< Current UTC minutes */
-                    uint8_t seconds;                /*!< Current UTC seconds */
-                } gga;                              /*!< GPGGA message */
-                struct{
-                   uint8_t is_valid;               /*!< Status whether GPS status is valid or not */
-                   uint8_t date;                   /*!< Current UTF date */
-                   uint8_t month;                  /*!< Current UTF month */
-                   uint8_t year;                   /*!< Current UTF year */
-                   gps_float_t speed;              /*!< Current spead over the ground in knots */
-                   gps_float_t coarse;             /*!< Current coarse made good */
-                   gps_float_t variation;          /*!< Current magnetic variation in degrees */
-               } rmc;                              /*!< GPRMC message */
-
-        } data;                                    /*!< Union with data for each information */
-    } p;                                           /*!< Structure with private data */
-}gps_t;
+#if GPS_CFG_COMPACT
+/**
+ * \brief           Get pointer to last valid GPGGA values
+ * \param[in]       gh: GPS handle
+ */
+#define gps_gga(gh)                         ((const gps_gga_t *)&(gh)->gga)
+
+/**
+ * \brief           Get pointer to last valid GPRMC values
+ * \param[in]       gh: GPS handle
+ */
+#define gps_rmc(gh)                         ((const gps_rmc_t *)&(gh)->rmc)
+#endif /* GPS_CFG_COMPACT */
 
 /*
  *  GPS Module Prototype Functions
@@ -109,7 +402,15 @@ typedef struct{
 
 uint8_t     gps_init(gps_t* gh);
 uint8_t     gps_process(gps_t* gh, const void* data, size_t len);
+uint8_t     gps_get_fix(const gps_t* gh, gps_fix_t* fix);
+void        gps_set_rx_time(gps_t* gh, gps_tick_t ts);
+uint8_t     gps_get_stats(const gps_t* gh, gps_stats_t* stats);
 
+struct gps_buff;
+size_t      gps_process_buff(gps_t* gh, struct gps_buff* buff);
 
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
 
 #endif /* GPS_H_ */
@@ -0,0 +1,692 @@
+/*
+ * gps.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ *
+ *  Header-only C++20 NMEA parser. Set of sentences, decoded fields and output are
+ *  template parameters, so every configuration compiles to its own state machine:
+ *  disabled sentences and fields cost nothing at runtime, there are no virtual
+ *  calls and no heap. Values are published as \ref gps_gga_t and \ref gps_rmc_t
+ *  records, to \ref gps_fix_t or directly to existing \ref gps_t handle.
+ *
+ *  Numbers are decoded while bytes arrive, terms are never copied to text, and
+ *  any talker ID is accepted. Sentences with fewer fields than C parser requires
+ *  are dropped. GGA epoch follows same calendar rules as C parser, dated by RMC
+ *  when its date is parsed. UBX frames are not decoded, use C parser for them.
+ *
+ *      gps::parser<> p;                        GGA and RMC, all fields, to gps_fix_t
+ *      p.process(std::as_bytes(std::span(line)));
+ *      p.out().get().gga.latitude;
+ *
+ *      gps::parser<gps::sentences<gps::sentence::gga>, gps::fields::position | gps::fields::time,
+ *          gps::out::handle> q(hgps);          GGA position and time only, to gps_t
+ *      q.process(hgps_buff);
+ */
+
+#ifndef GPS_HPP_
+#define GPS_HPP_
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+#include "gps.h"
+#include "gps_buff.h"
+
+namespace gps {
+
+/**
+ * \brief           Sentence types known to parser
+ */
+enum class sentence : std::uint8_t {
+    gga,                                        /*!< Position, altitude, quality and UTC time */
+    rmc,                                        /*!< Validity, speed, coarse, variation and UTC date */
+};
+
+/**
+ * \brief           Compile time set of sentences to parse
+ */
+template<sentence... S>
+struct sentences {};
+
+/**
+ * \brief           Groups of fields decoded by parser. Fields not selected stay `0`
+ */
+enum class fields : std::uint8_t {
+    time = 0x01,                                /*!< GGA UTC time and epoch */
+    position = 0x02,                            /*!< GGA latitude and longitude */
+    altitude = 0x04,                            /*!< GGA altitude and geoid separation */
+    quality = 0x08,                             /*!< GGA fix, satellites in use and HDOP, RMC validity */
+    motion = 0x10,                              /*!< RMC speed and coarse */
+    date = 0x20,                                /*!< RMC UTC time and date, dates GGA epoch */
+    variation = 0x40,                           /*!< RMC magnetic variation */
+    all = 0x7F,                                 /*!< All fields */
+};
+
+constexpr fields
+operator|(fields a, fields b) noexcept {
+    return static_cast<fields>(static_cast<std::uint8_t>(a) | static_cast<std::uint8_t>(b));
+}
+
+constexpr bool
+has(fields set, fields f) noexcept {
+    return (static_cast<std::uint8_t>(set) & static_cast<std::uint8_t>(f)) != 0;
+}
+
+/**
+ * \brief           Output policy, receives every published record
+ */
+template<class T>
+concept output = requires(T& o, const gps_gga_t& gga, const gps_rmc_t& rmc) {
+    o.gga(gga);
+    o.rmc(rmc);
+};
+
+namespace out {
+
+/**
+ * \brief           Output to snapshot of last valid values
+ */
+class fix {
+public:
+    void gga(const gps_gga_t& v) noexcept { fix_.gga = v; }
+    void rmc(const gps_rmc_t& v) noexcept { fix_.rmc = v; }
+    const gps_fix_t& get() const noexcept { return fix_; }
+
+private:
+    gps_fix_t fix_{};
+};
+
+/**
+ * \brief           Output to existing GPS handle, so code reading \ref gps_t keeps working.
+ *                  Must not be used together with \ref gps_process on the same handle
+ */
+class handle {
+public:
+    explicit handle(gps_t& gh) noexcept : gh_(&gh) {}
+
+    void
+    gga(const gps_gga_t& v) noexcept {
+#if GPS_CFG_COMPACT
+        gh_->gga = v;
+#else
+        gh_->latitude = v.latitude;
+        gh_->longitude = v.longitude;
+        gh_->altitude = v.altitude;
+        gh_->geo_sep = v.geo_sep;
+        gh_->hdop = v.hdop;
+#if GPS_CFG_PROTOCOL_UBX
+        gh_->pdop = v.pdop;
+#endif /* GPS_CFG_PROTOCOL_UBX */
+        gh_->sats_in_use = v.sats_in_use;
+        gh_->fix = v.fix;
+        gh_->hours = v.hours;
+        gh_->minutes = v.minutes;
+        gh_->seconds = v.seconds;
+        gh_->epoch = v.epoch;
+        gh_->timed = v.timed;
+        gh_->dated = v.dated;
+#if GPS_CFG_RX_TIMESTAMP
+        gh_->gga_rx_first = v.rx_first;
+        gh_->gga_rx_last = v.rx_last;
+#endif /* GPS_CFG_RX_TIMESTAMP */
+#endif /* GPS_CFG_COMPACT */
+    }
+
+    void
+    rmc(const gps_rmc_t& v) noexcept {
+#if GPS_CFG_COMPACT
+        gh_->rmc = v;
+#else
+        gh_->speed = v.speed;
+        gh_->coarse = v.coarse;
+        gh_->variation = v.variation;
+        gh_->is_valid = v.is_valid;
+        gh_->date = v.date;
+        gh_->month = v.month;
+        gh_->year = v.year;
+#if GPS_CFG_RX_TIMESTAMP
+        gh_->rmc_rx_first = v.rx_first;
+        gh_->rmc_rx_last = v.rx_last;
+#endif /* GPS_CFG_RX_TIMESTAMP */
+#endif /* GPS_CFG_COMPACT */
+    }
+
+    gps_t& get() const noexcept { return *gh_; }
+
+private:
+    gps_t* gh_;
+};
+
+} /* namespace out */
+
+namespace detail {
+
+/**
+ * \brief           Action taken at end of term
+ */
+enum class act : std::uint8_t {
+    skip = 0, tag,
+    gga_time, gga_lat, gga_ns, gga_lon, gga_ew, gga_fix, gga_sats, gga_hdop, gga_alt, gga_sep,
+    rmc_time, rmc_valid, rmc_speed, rmc_coarse, rmc_date, rmc_var, rmc_var_ew,
+};
+
+inline constexpr std::size_t max_terms = 13;    /* Term `0` is sentence tag */
+inline constexpr std::uint8_t max_digits = 18;  /* Digits of one number which fit to `uint64_t` */
+
+struct term_def {
+    std::uint8_t term;
+    act a;
+    fields group;
+};
+
+inline constexpr term_def gga_terms[] = {
+    { 1, act::gga_time, fields::time },
+    { 2, act::gga_lat, fields::position },
+    { 3, act::gga_ns, fields::position },
+    { 4, act::gga_lon, fields::position },
+    { 5, act::gga_ew, fields::position },
+    { 6, act::gga_fix, fields::quality },
+    { 7, act::gga_sats, fields::quality },
+    { 8, act::gga_hdop, fields::quality },
+    { 9, act::gga_alt, fields::altitude },
+    { 11, act::gga_sep, fields::altitude },
+};
+
+inline constexpr term_def rmc_terms[] = {
+    { 1, act::rmc_time, fields::date },
+    { 2, act::rmc_valid, fields::quality },
+    { 7, act::rmc_speed, fields::motion },
+    { 8, act::rmc_coarse, fields::motion },
+    { 9, act::rmc_date, fields::date },
+    { 10, act::rmc_var, fields::variation },
+    { 11, act::rmc_var_ew, fields::variation },
+};
+
+/**
+ * \brief           Pack 3 characters of sentence type, talker ID is not part of tag
+ */
+constexpr std::uint32_t
+tag(const char (&s)[4]) noexcept {
+    return (std::uint32_t(std::uint8_t(s[0])) << 16) | (std::uint32_t(std::uint8_t(s[1])) << 8)
+        | std::uint32_t(std::uint8_t(s[2]));
+}
+
+constexpr std::uint32_t
+tag_of(sentence s) noexcept {
+    return s == sentence::gga ? tag("GGA") : tag("RMC");
+}
+
+/**
+ * \brief           Minimal number of data fields after sentence type, same as C parser
+ */
+constexpr std::uint8_t
+fields_of(sentence s) noexcept {
+    return s == sentence::gga ? 14 : 11;
+}
+
+/**
+ * \brief           Build table of actions for terms of one sentence, with unselected fields skipped
+ */
+template<sentence S, fields F>
+constexpr std::array<act, max_terms>
+make_terms() noexcept {
+    std::array<act, max_terms> t{};
+    auto fill = [&t](const auto& defs) {
+        for (const term_def& d : defs) {
+            if (has(F, d.group)) {
+                t[d.term] = d.a;
+            }
+        }
+    };
+    if constexpr (S == sentence::gga) {
+        fill(gga_terms);
+    } else {
+        fill(rmc_terms);
+    }
+    return t;
+}
+
+/**
+ * \brief           Powers of ten, exact in `double` up to `1e22`
+ */
+inline constexpr std::array<double, max_digits + 1> pow10 = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+    1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18,
+};
+
+inline constexpr std::array<std::uint64_t, max_digits + 1> ipow10 = [] {
+    std::array<std::uint64_t, max_digits + 1> p{};
+    p[0] = 1;
+    for (std::size_t i = 1; i < p.size(); i++) {
+        p[i] = 10 * p[i - 1];
+    }
+    return p;
+}();
+
+inline constexpr std::uint32_t ms_per_day = 86400000;
+inline constexpr std::uint64_t us_per_day = 1000ULL * ms_per_day;
+
+/**
+ * \brief           Number of days from 1970-01-01 to date in years 2000 to 2099
+ */
+constexpr std::uint16_t
+days_from_civil(std::uint8_t date, std::uint8_t month, std::uint8_t year) noexcept {
+    constexpr std::uint16_t before[12] = { 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 };
+
+    return static_cast<std::uint16_t>(10957UL + 365UL * year + (year + 3) / 4 + before[month - 1] + (date - 1)
+        + ((year % 4) == 0 && month > 2));
+}
+
+/**
+ * \brief           Calendar state for GGA epoch, same rules as \ref gps_t `cal` of C parser
+ */
+struct calendar {
+    std::uint32_t ref = 0;                      /*!< Last known UTC time of day on `day` in units of ms, valid when `timed` is set */
+    std::uint16_t day = 0;                      /*!< Current UTC day, days since 1970-01-01 */
+    bool timed = false;                         /*!< Set after first sentence with time */
+    bool dated = false;                         /*!< Set once date is known, `day` counts from `0` before */
+
+    /**
+     * \brief       Take date of sentence as new reference
+     * \param[in]   tod: Time of day of sentence in units of milliseconds
+     * \param[in]   d, m, y: Day of month, month and year since 2000
+     */
+    void
+    set_date(std::uint32_t tod, std::uint8_t d, std::uint8_t m, std::uint8_t y) noexcept {
+        if (d < 1 || d > 31 || m < 1 || m > 12 || y > 99) {
+            return;
+        }
+        day = days_from_civil(d, m, y);
+        ref = tod;
+        timed = true;
+        dated = true;
+    }
+
+    /**
+     * \brief       Epoch of time of day on day nearest to last known time, crosses midnight before RMC
+     * \param[in]   tod: Time of day of sentence in units of milliseconds
+     */
+    gps_epoch_t
+    epoch(std::uint32_t tod) noexcept {
+        if (timed) {
+            if (tod + ms_per_day / 2 < ref) {   /* Passed midnight */
+                day++;
+            } else if (tod > ref + ms_per_day / 2 && day > 0) {
+                day--;                          /* Late sentence of previous day */
+            }
+        }
+        ref = tod;
+        timed = true;
+        return day * us_per_day + tod * 1000ULL;
+    }
+};
+
+/**
+ * \brief           Value of hexadecimal digit, `-1` when character is not one
+ */
+constexpr int
+hex(std::uint8_t c) noexcept {
+    return c >= '0' && c <= '9' ? c - '0'
+        : c >= 'A' && c <= 'F' ? c - 'A' + 10
+        : c >= 'a' && c <= 'f' ? c - 'a' + 10 : -1;
+}
+
+} /* namespace detail */
+
+template<class Set = sentences<sentence::gga, sentence::rmc>, fields F = fields::all, output Out = out::fix>
+class parser;
+
+/**
+ * \brief           NMEA parser specialized for set of sentences `S`, fields `F` and output `Out`
+ */
+template<sentence... S, fields F, output Out>
+class parser<sentences<S...>, F, Out> {
+    static constexpr std::size_t count = sizeof...(S);
+    static constexpr std::uint8_t none = 0xFF;
+    static_assert(count > 0 && count < none, "set of sentences must not be empty");
+
+    static constexpr std::array<sentence, count> types = { S... };
+    static constexpr std::array<std::uint32_t, count> tags = { detail::tag_of(S)... };
+    static constexpr std::array<std::uint8_t, count> min_fields = { detail::fields_of(S)... };
+    static constexpr std::array<std::array<detail::act, detail::max_terms>, count> terms = {
+        detail::make_terms<S, F>()...
+    };
+
+    enum class st : std::uint8_t { idle, body, crc_hi, crc_lo, end };
+
+public:
+    /**
+     * \brief       Construct parser, arguments are passed to output policy
+     */
+    template<class... A>
+        requires std::constructible_from<Out, A...>
+    explicit parser(A&&... args) noexcept : out_(std::forward<A>(args)...) {}
+
+    /**
+     * \brief       Process received data
+     * \param[in]   data: Received bytes
+     * \return      Number of records published to output
+     */
+    std::size_t
+    process(std::span<const std::byte> data) noexcept {
+        std::size_t before = published_;
+        for (std::byte b : data) {
+            step(static_cast<std::uint8_t>(b));
+        }
+        return published_ - before;
+    }
+
+    /**
+     * \brief       Process all data waiting in ring buffer, like \ref gps_process_buff
+     *
+     *              Blocks are split at marked bytes to pass their receive time to parser
+     * \param[in]   buff: Ring buffer with received data
+     * \return      Number of records published to output
+     */
+    std::size_t
+    process(gps_buff_t& buff) noexcept {
+        std::array<std::byte, 64> block;
+        std::size_t n, before = published_;
+#if GPS_CFG_RX_TIMESTAMP
+        std::size_t off;
+        gps_tick_t ts;
+#endif /* GPS_CFG_RX_TIMESTAMP */
+
+        for (;;) {
+            n = block.size();
+#if GPS_CFG_RX_TIMESTAMP
+            if (buff_mark_peek(&buff, &off, &ts)) {
+                if (off == 0) {                 /* Marked byte is next */
+                    set_rx_time(ts);
+                    off = 1;
+                }
+                n = off < n ? off : n;
+            }
+#endif /* GPS_CFG_RX_TIMESTAMP */
+            n = buff_read(&buff, block.data(), n);
+            if (n == 0) {
+                break;
+            }
+            process(std::span<const std::byte>(block.data(), n));
+        }
+        return published_ - before;
+    }
+
+    /**
+     * \brief       Set receive time of next byte, see \ref gps_set_rx_time
+     */
+    void
+    set_rx_time(gps_tick_t ts) noexcept {
+#if GPS_CFG_RX_TIMESTAMP
+        rx_now_ = ts;
+#else
+        (void)ts;
+#endif /* GPS_CFG_RX_TIMESTAMP */
+    }
+
+    Out& out() noexcept { return out_; }
+    const Out& out() const noexcept { return out_; }
+
+private:
+    void
+    step(std::uint8_t c) noexcept {
+        if (c == '$') {                         /* Start of sentence resets parser in any state */
+            start();
+            return;
+        }
+        switch (state_) {
+            case st::body:
+                if (c == ',') {
+                    crc_ ^= c;
+                    end_term();
+                } else if (c == '*') {
+                    end_term();
+                    state_ = st::crc_hi;
+                } else if (c == '\r' || c == '\n') {
+                    state_ = st::idle;          /* No checksum, drop sentence */
+                } else {
+                    crc_ ^= c;
+                    if (act_ != detail::act::skip) {
+                        accumulate(c);
+                    }
+                }
+                break;
+            case st::crc_hi:
+            case st::crc_lo: {
+                int h = detail::hex(c);
+                if (h < 0) {
+                    state_ = st::idle;
+                    break;
+                }
+                crc_rx_ = static_cast<std::uint8_t>((crc_rx_ << 4) | h);
+                state_ = state_ == st::crc_hi ? st::crc_lo : st::end;
+                break;
+            }
+            case st::end:
+                if (c == '\r' && crc_rx_ == crc_ && stat_ != none
+                    && term_ - 1 >= min_fields[stat_]) {  /* Term after `*` holds CRC */
+                    publish();
+                }
+                state_ = st::idle;              /* Published at most once */
+                break;
+            default:
+                break;
+        }
+    }
+
+    void
+    start() noexcept {
+        state_ = st::body;
+        crc_ = crc_rx_ = 0;
+        term_ = 0;
+        stat_ = none;
+        tag_ = 0;
+        timed_ = false;
+        act_ = detail::act::tag;
+        clear();
+#if GPS_CFG_RX_TIMESTAMP
+        rx_first_ = rx_now_;
+#endif /* GPS_CFG_RX_TIMESTAMP */
+    }
+
+    void
+    clear() noexcept {
+        mant_ = 0;
+        digits_ = frac_ = 0;
+        dot_ = neg_ = false;
+        first_ = 0;
+    }
+
+    void
+    accumulate(std::uint8_t c) noexcept {
+        if (act_ == detail::act::tag) {         /* Keep last 3 characters */
+            tag_ = ((tag_ << 8) | c) & 0xFFFFFFUL;
+            digits_++;
+        } else if (c >= '0' && c <= '9') {
+            if (digits_ < detail::max_digits) {
+                mant_ = 10 * mant_ + (c - '0');
+                digits_++;
+                frac_ += dot_;
+            }
+        } else if (c == '.') {
+            dot_ = true;
+        } else if (c == '-') {
+            neg_ = true;
+        } else if (first_ == 0) {
+            first_ = c;
+        }
+    }
+
+    void
+    end_term() noexcept {
+        if (term_ == 0) {
+            if (digits_ == 5) {                 /* Talker ID and sentence type */
+                for (std::size_t i = 0; i < count; i++) {
+                    if (tags[i] == tag_) {
+                        stat_ = static_cast<std::uint8_t>(i);
+                        if (types[i] == sentence::gga) {
+                            stage_.gga = gps_gga_t{};
+                        } else {
+                            stage_.rmc = gps_rmc_t{};
+                        }
+                        break;
+                    }
+                }
+            }
+        } else if (act_ != detail::act::skip) {
+            apply();
+        }
+        term_++;
+        act_ = stat_ != none && term_ < detail::max_terms ? terms[stat_][term_] : detail::act::skip;
+        clear();
+    }
+
+    /**
+     * \brief       Decimal value of term, correctly rounded for up to 15 significant digits
+     */
+    double
+    value() const noexcept {
+        double v = static_cast<double>(mant_) / detail::pow10[frac_];
+        return neg_ ? -v : v;
+    }
+
+    /**
+     * \brief       Integer part of term
+     */
+    std::uint32_t
+    integer() const noexcept {
+        return static_cast<std::uint32_t>(mant_ / detail::ipow10[frac_]);
+    }
+
+    /**
+     * \brief       Latitude or longitude in degrees, from `ddmm.mmmm` or `dddmm.mmmm`
+     */
+    gps_float_t
+    degrees() const noexcept {
+        double v = value();
+        double deg = static_cast<double>(static_cast<int>(v / 100));
+        return static_cast<gps_float_t>(deg + (v - deg * 100) / 60);
+    }
+
+    /**
+     * \brief       Time of day from `hhmmss.sss` in milliseconds, sets `timed_` unless field is empty.
+     *              Like C parser, only first 6 digits are used when more precede decimal point
+     */
+    void
+    time_of_day() noexcept {
+        int n = digits_ - frac_;                /* Digits before decimal point */
+        std::uint32_t i = integer();
+        std::uint64_t ms = mant_ % detail::ipow10[frac_];
+
+        if (n < 6) {
+            return;                             /* Empty field, receiver has no time yet */
+        }
+        i = static_cast<std::uint32_t>(i / detail::ipow10[n - 6]);
+        if (n > 6) {
+            ms = 0;
+        } else {
+            ms = frac_ <= 3 ? ms * detail::ipow10[3 - frac_] : ms / detail::ipow10[frac_ - 3];
+        }
+        tod_ = ((i / 10000 * 60 + i / 100 % 100) * 60 + i % 100) * 1000U + static_cast<std::uint32_t>(ms);
+        timed_ = true;
+    }
+
+    void
+    apply() noexcept {
+        gps_gga_t& g = stage_.gga;
+        gps_rmc_t& r = stage_.rmc;
+        std::uint32_t i;
+
+        switch (act_) {
+            case detail::act::gga_time: time_of_day(); break;
+            case detail::act::gga_lat: g.latitude = degrees(); break;
+            case detail::act::gga_ns: if (first_ == 'S' || first_ == 's') g.latitude = -g.latitude; break;
+            case detail::act::gga_lon: g.longitude = degrees(); break;
+            case detail::act::gga_ew: if (first_ == 'W' || first_ == 'w') g.longitude = -g.longitude; break;
+            case detail::act::gga_fix: g.fix = static_cast<std::uint8_t>(integer()); break;
+            case detail::act::gga_sats: g.sats_in_use = static_cast<std::uint8_t>(integer()); break;
+            case detail::act::gga_hdop: g.hdop = static_cast<gps_aux_float_t>(value()); break;
+            case detail::act::gga_alt: g.altitude = static_cast<gps_aux_float_t>(value()); break;
+            case detail::act::gga_sep: g.geo_sep = static_cast<gps_aux_float_t>(value()); break;
+            case detail::act::rmc_time: time_of_day(); break;
+            case detail::act::rmc_valid: r.is_valid = first_ == 'A'; break;
+            case detail::act::rmc_speed: r.speed = static_cast<gps_aux_float_t>(value()); break;
+            case detail::act::rmc_coarse: r.coarse = static_cast<gps_aux_float_t>(value()); break;
+            case detail::act::rmc_date:
+                if (digits_ == 6 && !dot_ && !neg_ && first_ == 0) {  /* Exactly `ddmmyy` like C parser */
+                    i = integer();
+                    r.date = static_cast<std::uint8_t>(i / 10000);
+                    r.month = static_cast<std::uint8_t>(i / 100 % 100);
+                    r.year = static_cast<std::uint8_t>(i % 100);
+                }
+                break;
+            case detail::act::rmc_var: r.variation = static_cast<gps_aux_float_t>(value()); break;
+            case detail::act::rmc_var_ew: if (first_ == 'W' || first_ == 'w') r.variation = -r.variation; break;
+            default: break;
+        }
+    }
+
+    void
+    publish() noexcept {
+        if (types[stat_] == sentence::gga) {
+#if GPS_CFG_RX_TIMESTAMP
+            stage_.gga.rx_first = rx_first_;
+            stage_.gga.rx_last = rx_now_;
+#endif /* GPS_CFG_RX_TIMESTAMP */
+            if (timed_) {
+                std::uint32_t sec = tod_ / 1000U;
+
+                stage_.gga.epoch = cal_.epoch(tod_);
+                stage_.gga.timed = 1;
+                stage_.gga.dated = cal_.dated;
+                stage_.gga.hours = static_cast<std::uint8_t>(sec / 3600U);
+                stage_.gga.minutes = static_cast<std::uint8_t>(sec / 60U % 60U);
+                stage_.gga.seconds = static_cast<std::uint8_t>(sec % 60U);
+            }
+            out_.gga(stage_.gga);
+        } else {
+#if GPS_CFG_RX_TIMESTAMP
+            stage_.rmc.rx_first = rx_first_;
+            stage_.rmc.rx_last = rx_now_;
+#endif /* GPS_CFG_RX_TIMESTAMP */
+            if (timed_) {
+                cal_.set_date(tod_, stage_.rmc.date, stage_.rmc.month, stage_.rmc.year);
+            }
+            out_.rmc(stage_.rmc);
+        }
+        published_++;
+    }
+
+    Out out_;                                   /*!< Output policy */
+    gps_rec_t stage_{};                         /*!< Staging record of sentence being parsed */
+    std::size_t published_ = 0;                 /*!< Number of published records */
+    detail::calendar cal_;                      /*!< Calendar state for GGA epoch, kept over sentences */
+    std::uint32_t tod_ = 0;                     /*!< UTC time of day of sentence in units of milliseconds */
+    std::uint64_t mant_ = 0;                    /*!< Digits of current term as integer */
+    std::uint32_t tag_ = 0;                     /*!< Last 3 characters of term `0` */
+#if GPS_CFG_RX_TIMESTAMP
+    gps_tick_t rx_now_ = 0;                     /*!< Receive time of byte being processed */
+    gps_tick_t rx_first_ = 0;                   /*!< Receive time of `$` of current sentence */
+#endif /* GPS_CFG_RX_TIMESTAMP */
+    st state_ = st::idle;                       /*!< Framing state */
+    detail::act act_ = detail::act::skip;       /*!< Action at end of current term */
+    std::uint8_t stat_ = none;                  /*!< Index of sentence in set, `none` when unknown */
+    std::uint8_t term_ = 0;                     /*!< Current term number, number of terms after `*` */
+    std::uint8_t crc_ = 0;                      /*!< Calculated checksum */
+    std::uint8_t crc_rx_ = 0;                   /*!< Received checksum */
+    std::uint8_t digits_ = 0;                   /*!< Number of digits (characters of term `0`) */
+    std::uint8_t frac_ = 0;                     /*!< Number of digits after decimal point */
+    std::uint8_t first_ = 0;                    /*!< First non-numeric character of term */
+    bool dot_ = false;                          /*!< Decimal point seen */
+    bool neg_ = false;                          /*!< Minus sign seen */
+    bool timed_ = false;                        /*!< Sentence carries valid time of day in `tod_` */
+};
+
+} /* namespace gps */
+
+#endif /* GPS_HPP_ */
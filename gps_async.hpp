@@ -0,0 +1,388 @@
+/*
+ * gps_async.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ *
+ *  Header-only C++20 asynchronous NMEA sources for Linux host applications.
+ *  One reactor waits on many serial ports or pipes with `epoll`. Each source reads
+ *  its descriptor into own GPS ring buffer, drives \ref gps_process in bulk and
+ *  queues completed fixes, which coroutines take with `co_await src.next()`.
+ *  Nothing polls: when queue of a source is full, its descriptor is removed from
+ *  `epoll` until consumer catches up, and data wait in kernel.
+ *
+ *      gps::async::task
+ *      track(gps::async::source<>& src) {
+ *          while (auto fix = co_await src.next()) {
+ *              ...                             New valid epoch in *fix
+ *          }
+ *      }
+ *
+ *      gps::async::reactor r;
+ *      gps::async::source<> a(r, fd1), b(r, fd2);
+ *      track(a);
+ *      track(b);
+ *      r.run();                                Returns when all sources are closed
+ *
+ *  Descriptors must be pollable (serial port, pipe, socket), regular files are not.
+ *  Sources do not own descriptors and must outlive reactor run and their coroutines.
+ */
+
+#ifndef GPS_ASYNC_HPP_
+#define GPS_ASYNC_HPP_
+
+#if defined(__linux__)
+
+#include <array>
+#include <cerrno>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <optional>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+
+#include "gps.h"
+#include "gps_buff.h"
+#include "gps_prof.h"
+
+namespace gps::async {
+
+/**
+ * \brief           Detached coroutine, starts at once and frees itself when it returns
+ */
+struct task {
+    struct promise_type {
+        task get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+namespace detail {
+
+/**
+ * \brief           Object registered to reactor
+ */
+struct pollable {
+    void (*on_event)(pollable* p, std::uint32_t events);   /*!< Called by reactor when descriptor is ready */
+};
+
+} /* namespace detail */
+
+/**
+ * \brief           Event loop over `epoll`, single thread
+ */
+class reactor {
+public:
+    reactor() noexcept : ep_(epoll_create1(EPOLL_CLOEXEC)) {}
+    ~reactor() { if (ep_ >= 0) close(ep_); }
+    reactor(const reactor&) = delete;
+    reactor& operator=(const reactor&) = delete;
+
+    bool valid() const noexcept { return ep_ >= 0; }
+
+    /**
+     * \brief       Number of sources not closed yet
+     */
+    std::size_t active() const noexcept { return active_; }
+
+    /**
+     * \brief       Wait for ready descriptors once and dispatch them
+     * \param[in]   timeout_ms: Timeout in units of milliseconds, `-1` to wait without limit
+     * \return      Number of dispatched events, `-1` on error
+     */
+    int
+    run_once(int timeout_ms = -1) noexcept {
+        std::array<epoll_event, 32> ev;
+        int n = epoll_wait(ep_, ev.data(), static_cast<int>(ev.size()), timeout_ms);
+
+        if (n < 0) {
+            return errno == EINTR ? 0 : -1;
+        }
+        for (int i = 0; i < n; i++) {
+            auto* p = static_cast<detail::pollable*>(ev[i].data.ptr);
+            p->on_event(p, ev[i].events);
+        }
+        return n;
+    }
+
+    /**
+     * \brief       Dispatch events until all sources are closed
+     */
+    void
+    run() noexcept {
+        while (active_ > 0 && run_once(-1) >= 0) {}
+    }
+
+    /* Used by sources */
+    bool
+    add(int fd, detail::pollable* p) noexcept {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.ptr = p;
+        return epoll_ctl(ep_, EPOLL_CTL_ADD, fd, &ev) == 0;
+    }
+
+    void remove(int fd) noexcept { epoll_ctl(ep_, EPOLL_CTL_DEL, fd, nullptr); }
+    void opened() noexcept { active_++; }
+    void closed() noexcept { active_--; }
+
+private:
+    int ep_;                                    /*!< `epoll` instance */
+    std::size_t active_ = 0;                    /*!< Number of sources not closed yet */
+};
+
+/**
+ * \brief           NMEA source on file descriptor
+ * \tparam          Size: Size of ring buffer in bytes
+ * \tparam          Depth: Number of fixes queued for consumer
+ */
+template<std::size_t Size = 4096, std::size_t Depth = 16>
+class source : detail::pollable {
+    static_assert(Size >= 128 && Depth > 0, "buffer must hold several sentences");
+
+public:
+    /**
+     * \brief       Awaitable next fix, `std::nullopt` once source is closed and queue is empty
+     */
+    class awaiter {
+    public:
+        explicit awaiter(source& s) noexcept : s_(&s) {}
+        bool await_ready() const noexcept { return s_->count_ > 0 || s_->closed_; }
+        void await_suspend(std::coroutine_handle<> h) noexcept { s_->waiter_ = h; }
+        std::optional<gps_fix_t> await_resume() noexcept { return s_->pop(); }
+
+    private:
+        source* s_;
+    };
+
+    /**
+     * \brief       Create source and register it to reactor. Descriptor is set to non-blocking
+     * \param[in]   r: Reactor
+     * \param[in]   fd: Readable descriptor, stays owned by caller
+     */
+    source(reactor& r, int fd) noexcept : r_(&r), fd_(fd) {
+        int fl;
+
+        on_event = [](detail::pollable* p, std::uint32_t events) {
+            static_cast<source*>(p)->ready(events);
+        };
+        gps_init(&gh_);
+        buff_init(&buff_, data_.data(), data_.size());
+        buff_init_marks(&buff_, marks_.data(), marks_.size());
+        r_->opened();
+        if ((fl = fcntl(fd_, F_GETFL)) < 0 || fcntl(fd_, F_SETFL, fl | O_NONBLOCK) < 0 || !r_->add(fd_, this)) {
+            err_ = errno;
+            close_source();
+        } else {
+            armed_ = true;
+        }
+    }
+
+    ~source() {
+        if (armed_) {
+            r_->remove(fd_);
+        }
+        if (!closed_) {
+            r_->closed();
+        }
+    }
+
+    source(const source&) = delete;
+    source& operator=(const source&) = delete;
+
+    /**
+     * \brief       Wait for next new valid epoch
+     */
+    awaiter next() noexcept { return awaiter(*this); }
+
+    bool closed() const noexcept { return closed_; }
+
+    /**
+     * \brief       Error number which closed source, `0` on end of file
+     */
+    int error() const noexcept { return err_; }
+
+    /**
+     * \brief       Parser of source, with values of last processed sentences
+     */
+    const gps_t& handle() const noexcept { return gh_; }
+
+private:
+    /**
+     * \brief       Descriptor is ready, read all it has and wake consumer
+     */
+    void
+    ready(std::uint32_t events) noexcept {
+        if (events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+            fill();
+        }
+        settle();
+        wake();
+    }
+
+    /**
+     * \brief       Read descriptor to ring buffer until it would block or buffer is full
+     */
+    void
+    fill() noexcept {
+        std::array<std::uint8_t, 512> tmp;
+        std::size_t room;
+        ssize_t n;
+
+        while ((room = buff_get_free(&buff_)) > 0) {
+            n = read(fd_, tmp.data(), room < tmp.size() ? room : tmp.size());
+            if (n > 0) {
+                buff_write_stamped(&buff_, tmp.data(), static_cast<std::size_t>(n), gps_prof_now());
+                continue;
+            }
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                err_ = n == 0 ? 0 : errno;
+                eof_ = true;
+                disarm();                       /* Hung up descriptor is always ready */
+            }
+            break;
+        }
+    }
+
+    /**
+     * \brief       Process buffered data while queue has room, then decide
+     *              whether descriptor should be waited for
+     */
+    void
+    settle() noexcept {
+        drain();
+        if (eof_ && buff_get_full(&buff_) == 0) {
+            close_source();
+        } else if (!eof_ && count_ < Depth && buff_get_free(&buff_) > 0) {
+            if (!armed_) {
+                armed_ = r_->add(fd_, this);
+            }
+        } else {
+            disarm();
+        }
+    }
+
+    /**
+     * \brief       Process ring buffer like \ref gps_process_buff, checking fix at every end of sentence
+     */
+    void
+    drain() noexcept {
+        std::array<std::uint8_t, 64> block;
+        const std::uint8_t *p, *eol;
+        std::size_t n, off, len;
+        gps_tick_t ts;
+
+        while (count_ < Depth) {
+            n = block.size();
+            if (buff_mark_peek(&buff_, &off, &ts)) {
+                if (off == 0) {                 /* Marked byte is next */
+                    gps_set_rx_time(&gh_, ts);
+                    off = 1;
+                }
+                n = off < n ? off : n;
+            }
+            n = buff_read(&buff_, block.data(), n);
+            if (n == 0) {
+                break;
+            }
+            p = block.data();
+            while ((eol = static_cast<const std::uint8_t*>(std::memchr(p, '\r', n))) != nullptr) {
+                len = static_cast<std::size_t>(eol - p) + 1;
+                gps_process(&gh_, p, len);      /* Check after every sentence, 10 Hz epochs may share block */
+                check();
+                p += len;
+                n -= len;
+            }
+            gps_process(&gh_, p, n);
+        }
+    }
+
+    /**
+     * \brief       Queue fix when new valid epoch was published
+     */
+    void
+    check() noexcept {
+        gps_fix_t fix;
+
+        gps_get_fix(&gh_, &fix);
+        if (fix.gga.fix && fix.gga.timed && fix.gga.epoch != last_key_ && count_ < Depth) {
+            last_key_ = fix.gga.epoch;
+            queue_[(head_ + count_) % Depth] = fix;
+            count_++;
+        }
+    }
+
+    std::optional<gps_fix_t>
+    pop() noexcept {
+        gps_fix_t fix;
+
+        if (count_ == 0) {
+            return std::nullopt;
+        }
+        fix = queue_[head_];
+        head_ = (head_ + 1) % Depth;
+        count_--;
+        if (!closed_) {
+            settle();                           /* Room in queue, continue with buffered data */
+        }
+        return fix;
+    }
+
+    void
+    wake() noexcept {
+        if (waiter_ && (count_ > 0 || closed_)) {
+            std::exchange(waiter_, nullptr).resume();
+        }
+    }
+
+    void
+    disarm() noexcept {
+        if (armed_) {
+            r_->remove(fd_);
+            armed_ = false;
+        }
+    }
+
+    void
+    close_source() noexcept {
+        disarm();
+        if (!closed_) {
+            closed_ = true;
+            r_->closed();
+        }
+    }
+
+    reactor* r_;                                /*!< Reactor */
+    int fd_;                                    /*!< Descriptor */
+    gps_t gh_;                                  /*!< Parser */
+    gps_buff_t buff_;                           /*!< Ring buffer */
+    std::array<std::uint8_t, Size> data_;       /*!< Ring buffer data */
+    std::array<gps_buff_mark_t, Size / 8> marks_;   /*!< Receive times of sentence delimiters */
+    std::array<gps_fix_t, Depth> queue_;        /*!< Fixes waiting for consumer */
+    std::size_t head_ = 0;                      /*!< Index of oldest fix in queue */
+    std::size_t count_ = 0;                     /*!< Number of fixes in queue */
+    gps_epoch_t last_key_ = GPS_EPOCH_NONE;     /*!< UTC epoch of last queued fix */
+    std::coroutine_handle<> waiter_;            /*!< Coroutine waiting for fix */
+    int err_ = 0;                               /*!< Error number which closed source */
+    bool armed_ = false;                        /*!< Descriptor is registered to `epoll` */
+    bool eof_ = false;                          /*!< Nothing more to read from descriptor */
+    bool closed_ = false;                       /*!< End of file and all data processed */
+};
+
+} /* namespace gps::async */
+
+#endif /* defined(__linux__) */
+
+#endif /* GPS_ASYNC_HPP_ */
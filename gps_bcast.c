@@ -0,0 +1,239 @@
+/*
+ * gps_bcast.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ */
+
+#include "gps_bcast.h"
+
+#define BCAST_IS_VALID(b)               ((b) != NULL && (b)->buff != NULL && (b)->size > 0)
+#define BCAST_READER_IS_VALID(b, id)    (BCAST_IS_VALID(b) && (id) < GPS_CFG_BCAST_READERS && (b)->readers[(id)].used)
+#define BCAST_MIN(x, y)                 ((x) < (y) ? (x) : (y))
+
+/**
+ * \brief           Get number of unread bytes between read and write pointer
+ * \param[in]       b: Broadcast buffer handle
+ * \param[in]       r: Read pointer
+ * \param[in]       w: Write pointer
+ * \return          Number of bytes ready to be read
+ */
+static size_t
+full_between(gps_bcast_t* b, size_t r, size_t w) {
+    return w >= r ? w - r : b->size - (r - w);
+}
+
+/**
+ * \brief           Initialize broadcast buffer with size and buffer data array
+ * \param[in]       b: Broadcast buffer handle
+ * \param[in]       buffdata: Pointer to memory to use as buffer data
+ * \param[in]       size: Size of `buffdata` in units of bytes
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+bcast_init(gps_bcast_t* b, void* buffdata, size_t size) {
+    if (b == NULL || buffdata == NULL || size < 2) {
+        return 0;
+    }
+    memset(b, 0x00, sizeof(*b));
+    b->buff = buffdata;
+    b->size = size;
+    return 1;
+}
+
+/**
+ * \brief           Register new reader. Reader starts with empty view, at current write pointer
+ * \param[in]       b: Broadcast buffer handle
+ * \param[out]      id: Reader ID to use with read functions
+ * \return          `1` on success, `0` when all readers are in use
+ */
+uint8_t
+bcast_reader_add(gps_bcast_t* b, uint8_t* id) {
+    uint8_t i;
+
+    if (!BCAST_IS_VALID(b) || id == NULL) {
+        return 0;
+    }
+    for (i = 0; i < GPS_CFG_BCAST_READERS; i++) {
+        if (!b->readers[i].used) {
+            memset(&b->readers[i], 0x00, sizeof(b->readers[i]));
+            b->readers[i].r = b->w;
+            b->readers[i].used = 1;
+            *id = i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Unregister reader, its unread data no longer limit the writer
+ * \param[in]       b: Broadcast buffer handle
+ * \param[in]       id: Reader ID
+ */
+void
+bcast_reader_remove(gps_bcast_t* b, uint8_t id) {
+    if (BCAST_READER_IS_VALID(b, id)) {
+        b->readers[id].used = 0;
+    }
+}
+
+/**
+ * \brief           Get number of bytes writer can write, limited by slowest reader
+ * \param[in]       b: Broadcast buffer handle
+ * \return          Number of free bytes in memory
+ */
+size_t
+bcast_get_free(gps_bcast_t* b) {
+    size_t full, max = 0, w;
+    uint8_t i;
+
+    if (!BCAST_IS_VALID(b)) {
+        return 0;
+    }
+    w = b->w;
+    for (i = 0; i < GPS_CFG_BCAST_READERS; i++) {
+        if (b->readers[i].used) {
+            full = full_between(b, b->readers[i].r, w);
+            max = full > max ? full : max;
+        }
+    }
+    return b->size - 1 - max;
+}
+
+/**
+ * \brief           Write data to buffer, visible to all registered readers
+ *
+ *                  Bytes which do not fit are dropped and counted as overrun
+ *                  of every reader which was limiting the writer
+ * \param[in]       b: Broadcast buffer handle
+ * \param[in]       data: Pointer to data to write into buffer
+ * \param[in]       btw: Number of bytes to write
+ * \return          Number of bytes written to buffer
+ */
+size_t
+bcast_write(gps_bcast_t* b, const void* data, size_t btw) {
+    const uint8_t* d = data;
+    size_t full[GPS_CFG_BCAST_READERS], max = 0, tocopy, w;
+    uint8_t i;
+
+    if (!BCAST_IS_VALID(b) || btw == 0) {
+        return 0;
+    }
+
+    /* Find slowest reader and update lag statistics */
+    w = b->w;
+    for (i = 0; i < GPS_CFG_BCAST_READERS; i++) {
+        full[i] = b->readers[i].used ? full_between(b, b->readers[i].r, w) : 0;
+        max = full[i] > max ? full[i] : max;
+    }
+    if (btw > b->size - 1 - max) {
+        for (i = 0; i < GPS_CFG_BCAST_READERS; i++) {
+            if (b->readers[i].used && full[i] == max) {
+                b->readers[i].overruns += (uint32_t)(btw - (b->size - 1 - max));
+            }
+        }
+        btw = b->size - 1 - max;
+    }
+
+    /* Write data in linear part, then overflow part */
+    tocopy = BCAST_MIN(b->size - w, btw);
+    memcpy(&b->buff[w], d, tocopy);
+    if (btw > tocopy) {
+        memcpy(b->buff, &d[tocopy], btw - tocopy);
+    }
+    w += btw;
+    if (w >= b->size) {
+        w -= b->size;
+    }
+    b->w = w;
+
+    for (i = 0; i < GPS_CFG_BCAST_READERS; i++) {
+        if (b->readers[i].used && full[i] + btw > b->readers[i].max_lag) {
+            b->readers[i].max_lag = full[i] + btw;
+        }
+    }
+    return btw;
+}
+
+/**
+ * \brief           Get number of bytes waiting for reader
+ * \param[in]       b: Broadcast buffer handle
+ * \param[in]       id: Reader ID
+ * \return          Number of bytes ready to be read
+ */
+size_t
+bcast_get_full(gps_bcast_t* b, uint8_t id) {
+    if (!BCAST_READER_IS_VALID(b, id)) {
+        return 0;
+    }
+    return full_between(b, b->readers[id].r, b->w);
+}
+
+/**
+ * \brief           Get pointer to continuous block of data waiting for reader, without copying
+ *
+ *                  Use \ref bcast_skip to mark data as read when done
+ * \param[in]       b: Broadcast buffer handle
+ * \param[in]       id: Reader ID
+ * \param[out]      ptr: Pointer to first unread byte
+ * \return          Number of bytes in continuous block
+ */
+size_t
+bcast_get_linear_block(gps_bcast_t* b, uint8_t id, const uint8_t** ptr) {
+    size_t r, w;
+
+    if (!BCAST_READER_IS_VALID(b, id) || ptr == NULL) {
+        return 0;
+    }
+    r = b->readers[id].r;
+    w = b->w;
+    *ptr = &b->buff[r];
+    return w >= r ? w - r : b->size - r;
+}
+
+/**
+ * \brief           Mark data as read by reader
+ * \param[in]       b: Broadcast buffer handle
+ * \param[in]       id: Reader ID
+ * \param[in]       len: Number of bytes to skip
+ * \return          Number of bytes skipped
+ */
+size_t
+bcast_skip(gps_bcast_t* b, uint8_t id, size_t len) {
+    size_t r;
+
+    if (!BCAST_READER_IS_VALID(b, id)) {
+        return 0;
+    }
+    len = BCAST_MIN(len, bcast_get_full(b, id));
+    r = b->readers[id].r + len;
+    if (r >= b->size) {
+        r -= b->size;
+    }
+    b->readers[id].r = r;
+    return len;
+}
+
+/**
+ * \brief           Copy data waiting for reader and mark them as read
+ * \param[in]       b: Broadcast buffer handle
+ * \param[in]       id: Reader ID
+ * \param[out]      data: Pointer to output memory
+ * \param[in]       btr: Number of bytes to read
+ * \return          Number of bytes read and copied to data array
+ */
+size_t
+bcast_read(gps_bcast_t* b, uint8_t id, void* data, size_t btr) {
+    uint8_t* d = data;
+    const uint8_t* p;
+    size_t n, total = 0;
+
+    while (total < btr && (n = bcast_get_linear_block(b, id, &p)) > 0) {
+        n = BCAST_MIN(n, btr - total);
+        memcpy(&d[total], p, n);
+        bcast_skip(b, id, n);
+        total += n;
+    }
+    return total;
+}
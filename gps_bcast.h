@@ -0,0 +1,66 @@
+/*
+ * gps_bcast.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ */
+
+#ifndef GPS_BCAST_H_
+#define GPS_BCAST_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \brief           Maximum number of readers of one broadcast buffer
+ */
+#ifndef GPS_CFG_BCAST_READERS
+#define GPS_CFG_BCAST_READERS               4
+#endif
+
+/**
+ * \brief           Reader of broadcast buffer
+ */
+typedef struct {
+    size_t r;                                   /*!< Next read pointer of this reader */
+    size_t max_lag;                             /*!< Largest number of unread bytes seen by writer */
+    uint32_t overruns;                          /*!< Number of bytes writer dropped because this reader was slowest */
+    uint8_t used;                               /*!< Set to `1` when reader is registered */
+} gps_bcast_reader_t;
+
+/**
+ * \brief           Broadcast buffer structure, one writer and many readers with own read pointers.
+ *                  Writer can use only space already read by all readers
+ */
+typedef struct {
+    uint8_t* buff;                              /*!< Pointer to buffer data */
+    size_t size;                                /*!< Size of buffer data. Size of actual buffer is `1` byte less than value holds */
+    size_t w;                                   /*!< Next write pointer */
+    gps_bcast_reader_t readers[GPS_CFG_BCAST_READERS];  /*!< Registered readers */
+} gps_bcast_t;
+
+/* Broadcast buffer prototypes */
+uint8_t     bcast_init(gps_bcast_t* b, void* buffdata, size_t size);
+uint8_t     bcast_reader_add(gps_bcast_t* b, uint8_t* id);
+void        bcast_reader_remove(gps_bcast_t* b, uint8_t id);
+
+/* Write functions */
+size_t      bcast_write(gps_bcast_t* b, const void* data, size_t btw);
+size_t      bcast_get_free(gps_bcast_t* b);
+
+/* Read functions, per reader */
+size_t      bcast_read(gps_bcast_t* b, uint8_t id, void* data, size_t btr);
+size_t      bcast_get_full(gps_bcast_t* b, uint8_t id);
+size_t      bcast_get_linear_block(gps_bcast_t* b, uint8_t id, const uint8_t** ptr);
+size_t      bcast_skip(gps_bcast_t* b, uint8_t id, size_t len);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* GPS_BCAST_H_ */
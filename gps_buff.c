@@ -6,10 +6,187 @@
  */
 
 #include "gps_buff.h"
+#include "gps_prof.h"
 
 
 #define BUF_IS_VALID(b)                 ((b) != NULL && (b)->buff != NULL && (b)->size > 0)
 #define BUF_MIN(x, y)                   ((x) < (y) ? (x) : (y))
+#define BUF_UBX_SYNC1                   0xB5
+#define BUF_UBX_SYNC2                   0x62
+#define BUF_UBX_MAX_LEN                 1024    /* Same limit as parser, longer frames are corrupted */
+
+/* Writer position in UBX frame, for marks */
+#define BUF_UBX_S_IDLE                  0
+#define BUF_UBX_S_SYNC2                 1
+#define BUF_UBX_S_CLASS                 2
+#define BUF_UBX_S_ID                    3
+#define BUF_UBX_S_LEN1                  4
+#define BUF_UBX_S_LEN2                  5
+#define BUF_UBX_S_BODY                  6
+
+#if GPS_CFG_PROTOCOL_UBX
+#define BUF_IS_MARKED(ch)               ((ch) == '$' || (ch) == '\r' || (ch) == BUF_UBX_SYNC1)  /* Sentence delimiters and UBX sync which get receive time */
+#else
+#define BUF_IS_MARKED(ch)               ((ch) == '$' || (ch) == '\r')  /* Sentence delimiters which get receive time */
+#endif /* GPS_CFG_PROTOCOL_UBX */
+
+#if defined(__TI_ARM__)
+#define BUF_IRQ_DISABLE()               __asm(" cpsid i")
+#define BUF_IRQ_ENABLE()                __asm(" cpsie i")
+#elif defined(__GNUC__) && (defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__))
+#define BUF_IRQ_DISABLE()               __asm volatile ("cpsid i" ::: "memory")
+#define BUF_IRQ_ENABLE()                __asm volatile ("cpsie i" ::: "memory")
+#else
+#define BUF_IRQ_DISABLE()               /* Host builds, sleep backend is not used there */
+#define BUF_IRQ_ENABLE()
+#endif
+
+/**
+ * \brief           Get distance of mark from read pointer
+ * \param[in]       buff: Buffer handle
+ * \param[in]       r: Read pointer to measure from
+ * \return          Number of bytes between read pointer and marked byte
+ */
+static size_t
+mark_offset(gps_buff_t* buff, size_t r) {
+    size_t pos = buff->marks[buff->mr].pos;
+    return pos >= r ? pos - r : buff->size - (r - pos);
+}
+
+/**
+ * \brief           Get number of bytes up to and including first new line character
+ * \param[in]       buff: Buffer handle
+ * \param[in]       min: Unused
+ * \return          Number of bytes to read to get complete line, `0` if there is no line.
+ *                  When buffer is full without new line, all bytes, so writer is not blocked forever
+ */
+static size_t
+cond_eol(gps_buff_t* buff, size_t min) {
+    size_t full, tocopy;
+    const uint8_t* p;
+
+    (void)min;
+    full = buff_get_full(buff);
+    tocopy = BUF_MIN(buff->size - buff->r, full);
+    p = memchr(&buff->buff[buff->r], '\n', tocopy);
+    if (p != NULL) {
+        return (size_t)(p - &buff->buff[buff->r]) + 1;
+    }
+    p = memchr(buff->buff, '\n', full - tocopy);
+    if (p != NULL) {
+        return tocopy + (size_t)(p - buff->buff) + 1;
+    }
+    return full == buff->size - 1 ? full : 0;
+}
+
+/**
+ * \brief           Get number of bytes in buffer if there are at least `min`
+ * \param[in]       buff: Buffer handle
+ * \param[in]       min: Minimal number of bytes
+ * \return          Number of bytes ready to be read, `0` if less than `min`
+ */
+static size_t
+cond_full(gps_buff_t* buff, size_t min) {
+    size_t full = buff_get_full(buff);
+    return full >= min ? full : 0;
+}
+
+/**
+ * \brief           Block until condition is met or timeout expires
+ * \param[in]       buff: Buffer handle
+ * \param[in]       cond: Condition, returns non-zero when met
+ * \param[in]       min: Argument passed to condition
+ * \param[in]       timeout_ms: Timeout in units of milliseconds
+ * \return          Value returned by condition, `0` on timeout
+ */
+static size_t
+wait_cond(gps_buff_t* buff, size_t (*cond)(gps_buff_t*, size_t), size_t min, uint32_t timeout_ms) {
+    gps_tick_t last = gps_prof_now(), now;
+    uint32_t tps = gps_prof_ticks_per_sec(), seq, left = timeout_ms, max_ms = GPS_BUFF_WAIT_FOREVER;
+    uint64_t ticks = 0, elapsed, half;
+    size_t res;
+
+    if (!BUF_IS_VALID(buff)) {
+        return 0;
+    }
+    if (tps > 0) {                              /* Single wait must end before tick counter wraps once */
+        half = (uint64_t)((gps_tick_t)-1 / 2U);
+        max_ms = half / tps >= GPS_BUFF_WAIT_FOREVER / 1000U ? GPS_BUFF_WAIT_FOREVER - 1U : (uint32_t)(half * 1000U / tps);
+        max_ms = max_ms > 0 ? max_ms : 1;
+    }
+    for (;;) {
+        seq = buff->waiter != NULL ? buff->waiter->prepare(buff->waiter) : 0;
+        res = cond(buff, min);
+        if (res > 0 || buff->waiter == NULL || timeout_ms == 0) {
+            return res;
+        }
+        if (timeout_ms != GPS_BUFF_WAIT_FOREVER && tps > 0) {
+            now = gps_prof_now();
+            ticks += (gps_tick_t)(now - last);  /* Sum of short deltas, total does not wrap */
+            last = now;
+            elapsed = ticks / tps * 1000U + ticks % tps * 1000U / tps;
+            if (elapsed >= timeout_ms) {
+                return 0;
+            }
+            left = (uint32_t)(timeout_ms - elapsed);
+        }
+        if (!buff->waiter->wait(buff->waiter, seq, BUF_MIN(left, max_ms)) && tps == 0) {
+            return cond(buff, min);             /* Timeout reported by backend, no clock to check it here */
+        }
+    }
+}
+
+#if GPS_CFG_PROTOCOL_UBX
+/**
+ * \brief           Follow UBX frame being written, so bytes of its header and payload are not marked
+ * \param[in]       buff: Buffer handle
+ * \param[in]       ch: Written byte
+ * \return          `1` when byte is part of frame after sync byte, `0` otherwise
+ */
+static uint8_t
+ubx_skip(gps_buff_t* buff, uint8_t ch) {
+    switch (buff->ubx_state) {
+        case BUF_UBX_S_IDLE:
+            return 0;
+        case BUF_UBX_S_SYNC2:
+            buff->ubx_state = ch == BUF_UBX_SYNC2 ? BUF_UBX_S_CLASS : BUF_UBX_S_IDLE;
+            return buff->ubx_state != BUF_UBX_S_IDLE;
+        case BUF_UBX_S_CLASS:
+        case BUF_UBX_S_ID:
+            buff->ubx_state++;
+            return 1;
+        case BUF_UBX_S_LEN1:
+            buff->ubx_left = ch;
+            buff->ubx_state = BUF_UBX_S_LEN2;
+            return 1;
+        case BUF_UBX_S_LEN2:
+            buff->ubx_left |= (uint16_t)ch << 8;
+            buff->ubx_state = buff->ubx_left <= BUF_UBX_MAX_LEN ? BUF_UBX_S_BODY : BUF_UBX_S_IDLE;
+            buff->ubx_left += 2;                /* Checksum */
+            return 1;
+        default:
+            if (--buff->ubx_left == 0) {
+                buff->ubx_state = BUF_UBX_S_IDLE;
+            }
+            return 1;
+    }
+}
+#endif /* GPS_CFG_PROTOCOL_UBX */
+
+/**
+ * \brief           Remove marks of bytes which were already read
+ * \param[in]       buff: Buffer handle
+ * \param[in]       r: Read pointer before read operation
+ * \param[in]       count: Number of bytes read
+ */
+static void
+marks_consume(gps_buff_t* buff, size_t r, size_t count) {
+    while (buff->mr != buff->mw && mark_offset(buff, r) < count) {
+        if (++buff->mr >= buff->marks_size) {
+            buff->mr = 0;
+        }
+    }
+}
 
 /**
  * \brief           Initialize buffer handle to default values with size and buffer data array
@@ -89,6 +266,8 @@ buff_write(gps_buff_t* buff, const void* data, size_t btw){
             return 0;
         }
 
+        GPS_PROF_BEGIN(GPS_PROF_BUFF_WRITE);    /* Early returns above add no sample */
+
         /* Step 1: Write data to linear part of buffer */
         tocopy = BUF_MIN(buff->size - buff->w, btw);
         memcpy(&buff->buff[buff->w], d, tocopy);
@@ -104,6 +283,10 @@ buff_write(gps_buff_t* buff, const void* data, size_t btw){
         if (buff->w >= buff->size) {
             buff->w = 0;
         }
+        if (buff->waiter != NULL) {
+            buff->waiter->notify(buff->waiter); /* Wake up reader */
+        }
+        GPS_PROF_END(GPS_PROF_BUFF_WRITE);
         return tocopy + btw;
 }
 
@@ -144,7 +327,7 @@ buff_get_full(gps_buff_t* buff){
  */
 size_t
 buff_read(gps_buff_t* buff, void* data, size_t btr){
-       size_t tocopy, full;
+       size_t tocopy, full, r;
        uint8_t *d = data;
 
        if (!BUF_IS_VALID(buff) || btr == 0) {
@@ -159,6 +342,7 @@ buff_read(gps_buff_t* buff, void* data, size_t btr){
        }
 
        /* Step 1: Read data from linear part of buffer */
+       r = buff->r;
        tocopy = BUF_MIN(buff->size - buff->r, btr);
        memcpy(d, &buff->buff[buff->r], tocopy);
        buff->r += tocopy;
@@ -174,5 +358,209 @@ buff_read(gps_buff_t* buff, void* data, size_t btr){
        if (buff->r >= buff->size) {
            buff->r = 0;
        }
+
+       /* Step 4: Drop receive time marks of bytes read */
+       if (buff->marks != NULL) {
+           marks_consume(buff, r, tocopy + btr);
+       }
        return tocopy + btr;
 }
+
+/**
+ * \brief           Attach side ring for receive time marks to buffer
+ *
+ *                  Every `$`, `\r` and UBX sync byte written with \ref buff_write_stamped gets a mark,
+ *                  so parser knows when each sentence started and ended on the wire
+ * \param[in]       buff: Buffer handle, initialized with \ref buff_init
+ * \param[in]       marks: Memory for marks ring
+ * \param[in]       count: Number of entries in `marks`. Maximum number of marks is `count - 1`
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+buff_init_marks(gps_buff_t* buff, gps_buff_mark_t* marks, size_t count) {
+    if (!BUF_IS_VALID(buff) || marks == NULL || count < 2) {
+        return 0;
+    }
+    buff->marks = marks;
+    buff->marks_size = count;
+    buff->mr = buff->mw = 0;
+#if GPS_CFG_PROTOCOL_UBX
+    buff->ubx_state = BUF_UBX_S_IDLE;
+#endif /* GPS_CFG_PROTOCOL_UBX */
+    return 1;
+}
+
+/**
+ * \brief           Write data to buffer and mark sentence delimiters with receive time
+ *
+ *                  Bytes inside UBX frames are not marked, only their sync byte
+ * \note            Marks are added before data is published and reader is notified,
+ *                  so reader never takes delimiter without its mark. Marks of bytes
+ *                  not written yet are not visible to \ref buff_mark_peek
+ * \param[in]       buff: Buffer handle
+ * \param[in]       data: Pointer to data to write into buffer
+ * \param[in]       btw: Number of bytes to write
+ * \param[in]       ts: Receive time of data
+ * \return          Number of bytes written to buffer
+ */
+size_t
+buff_write_stamped(gps_buff_t* buff, const void* data, size_t btw, gps_tick_t ts) {
+    const uint8_t* d = data;
+    size_t w, i, mw;
+
+    if (!BUF_IS_VALID(buff) || buff->marks == NULL) {
+        return buff_write(buff, data, btw);
+    }
+    btw = BUF_MIN(buff_get_free(buff), btw);    /* Reader only frees more space until data are written */
+    w = buff->w;
+    for (i = 0; i < btw; i++) {
+#if GPS_CFG_PROTOCOL_UBX
+        if (ubx_skip(buff, d[i])) {
+            /* Header or payload byte of UBX frame */
+        } else
+#endif /* GPS_CFG_PROTOCOL_UBX */
+        if (BUF_IS_MARKED(d[i])) {
+            mw = buff->mw + 1;
+            if (mw >= buff->marks_size) {
+                mw = 0;
+            }
+            if (mw != buff->mr) {               /* When marks ring is full, sentence gets no receive time */
+                buff->marks[buff->mw].pos = w;
+                buff->marks[buff->mw].ts = ts;
+                buff->mw = mw;
+            }
+#if GPS_CFG_PROTOCOL_UBX
+            if (d[i] == BUF_UBX_SYNC1) {
+                buff->ubx_state = BUF_UBX_S_SYNC2;
+            }
+#endif /* GPS_CFG_PROTOCOL_UBX */
+        }
+        if (++w >= buff->size) {
+            w = 0;
+        }
+    }
+    return buff_write(buff, data, btw);         /* Publish data and notify reader */
+}
+
+/**
+ * \brief           Get next marked byte waiting in buffer
+ * \param[in]       buff: Buffer handle
+ * \param[out]      offset: Number of bytes to read before marked byte
+ * \param[out]      ts: Receive time of marked byte
+ * \return          `1` when marked byte is in buffer, `0` otherwise
+ */
+uint8_t
+buff_mark_peek(gps_buff_t* buff, size_t* offset, gps_tick_t* ts) {
+    size_t full, off;
+
+    if (!BUF_IS_VALID(buff) || buff->marks == NULL) {
+        return 0;
+    }
+    full = buff_get_full(buff);
+    if (buff->mr != buff->mw) {                 /* Marks of read bytes were removed by buff_read */
+        off = mark_offset(buff, buff->r);
+        if (off < full) {
+            *offset = off;
+            *ts = buff->marks[buff->mr].ts;
+            return 1;
+        }
+    }
+    return 0;                                   /* No mark, or its byte is not published yet */
+}
+
+/**
+ * \brief           Attach wait/notify backend to buffer
+ * \param[in]       buff: Buffer handle, initialized with \ref buff_init
+ * \param[in]       waiter: Backend, `NULL` to detach
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+buff_set_waiter(gps_buff_t* buff, gps_buff_waiter_t* waiter) {
+    if (!BUF_IS_VALID(buff)) {
+        return 0;
+    }
+    buff->waiter = waiter;
+    return 1;
+}
+
+/**
+ * \brief           Wait until buffer holds at least `min` bytes
+ * \note            Without backend, function does not block and only checks buffer
+ * \param[in]       buff: Buffer handle
+ * \param[in]       min: Minimal number of bytes to wait for
+ * \param[in]       timeout_ms: Timeout in units of milliseconds, \ref GPS_BUFF_WAIT_FOREVER to wait without limit
+ * \return          Number of bytes ready to be read, `0` on timeout
+ */
+size_t
+buff_wait(gps_buff_t* buff, size_t min, uint32_t timeout_ms) {
+    return wait_cond(buff, cond_full, min > 0 ? min : 1, timeout_ms);
+}
+
+/**
+ * \brief           Wait until buffer holds end of sentence (new line character)
+ * \param[in]       buff: Buffer handle
+ * \param[in]       timeout_ms: Timeout in units of milliseconds, \ref GPS_BUFF_WAIT_FOREVER to wait without limit
+ * \return          Number of bytes up to and including end of sentence, `0` on timeout
+ */
+size_t
+buff_wait_eol(gps_buff_t* buff, uint32_t timeout_ms) {
+    return wait_cond(buff, cond_eol, 0, timeout_ms);
+}
+
+/**
+ * \brief           Get notification sequence of sleep backend
+ */
+static uint32_t
+sleep_prepare(gps_buff_waiter_t* w) {
+    return ((gps_buff_sleep_waiter_t *)w)->seq;
+}
+
+/**
+ * \brief           Sleep until interrupt, unless notification came after `seq` was taken
+ */
+static uint8_t
+sleep_wait(gps_buff_waiter_t* w, uint32_t seq, uint32_t timeout_ms) {
+    gps_buff_sleep_waiter_t* sw = (gps_buff_sleep_waiter_t *)w;
+
+    (void)timeout_ms;                           /* Any interrupt (SysTick, UART) ends the sleep */
+    BUF_IRQ_DISABLE();                          /* Notification between check and WFI stays pending */
+    if (sw->seq == seq) {
+        sw->sleep();                            /* WFI wakes up on pending interrupt also when masked */
+    }
+    BUF_IRQ_ENABLE();                           /* Pending handler runs here */
+    return sw->seq != seq;
+}
+
+/**
+ * \brief           Notify sleep backend, called from interrupt
+ */
+static void
+sleep_notify(gps_buff_waiter_t* w) {
+    ((gps_buff_sleep_waiter_t *)w)->seq++;
+}
+
+/**
+ * \brief           Initialize backend which sleeps until interrupt
+ *
+ *                  Writer must run in interrupt context, which wakes up the core.
+ *                  Timeouts are checked on every wake up with profiling clock,
+ *                  so a periodic interrupt is needed for timeouts without received data,
+ *                  at least once per half period of profiling tick counter.
+ *                  All interrupts notifying same backend must run at same priority,
+ *                  `seq` increment is not atomic and must not be preempted by another writer
+ * \param[in]       w: Backend to initialize
+ * \param[in]       sleep: Function to enter sleep until next interrupt, for example `SysCtlSleep`
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+buff_sleep_waiter_init(gps_buff_sleep_waiter_t* w, void (*sleep)(void)) {
+    if (w == NULL || sleep == NULL) {
+        return 0;
+    }
+    w->ops.prepare = sleep_prepare;
+    w->ops.wait = sleep_wait;
+    w->ops.notify = sleep_notify;
+    w->seq = 0;
+    w->sleep = sleep;
+    return 1;
+}
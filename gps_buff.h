@@ -12,15 +12,78 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "gps.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
 /**
- * \brief           Buffer structure
+ * \brief           Receive time mark of single byte in buffer
  */
 typedef struct {
+    size_t pos;                                 /*!< Position of marked byte in buffer data */
+    gps_tick_t ts;                              /*!< Receive time of marked byte */
+} gps_buff_mark_t;
+
+/**
+ * \brief           Timeout value to wait without limit
+ */
+#define GPS_BUFF_WAIT_FOREVER           0xFFFFFFFFUL
+
+/**
+ * \brief           Wait/notify backend of buffer.
+ *                  Backend structures embed it as first member
+ */
+typedef struct gps_buff_waiter {
+    /**
+     * \brief       Get notification sequence before buffer state is checked
+     * \return      Sequence number passed to `wait`
+     */
+    uint32_t (*prepare)(struct gps_buff_waiter* w);
+
+    /**
+     * \brief       Block until notification newer than `seq` or timeout
+     * \return      `1` when notified, `0` on timeout
+     */
+    uint8_t (*wait)(struct gps_buff_waiter* w, uint32_t seq, uint32_t timeout_ms);
+
+    /**
+     * \brief       Wake up waiting reader. Called by writer after data are written
+     */
+    void (*notify)(struct gps_buff_waiter* w);
+} gps_buff_waiter_t;
+
+/**
+ * \brief           Backend which sleeps until next interrupt, for bare metal targets
+ */
+typedef struct {
+    gps_buff_waiter_t ops;                      /*!< Backend functions, must be first */
+    volatile uint32_t seq;                      /*!< Notification sequence, incremented in interrupt.
+                                                    Writers must run at same interrupt priority */
+    void (*sleep)(void);                        /*!< Function entering sleep until interrupt, `WFI` */
+} gps_buff_sleep_waiter_t;
+
+/**
+ * \brief           Buffer structure
+ */
+typedef struct gps_buff {
     uint8_t* buff;                              /*!< Pointer to buffer data.
                                                     Buffer is considered initialized when `buff != NULL` and `size > 0` */
     size_t size;                                /*!< Size of buffer data. Size of actual buffer is `1` byte less than value holds */
     size_t r;                                   /*!< Next read pointer. Buffer is considered empty when `r == w` and full when `w == r - 1` */
     size_t w;                                   /*!< Next write pointer. Buffer is considered empty when `r == w` and full when `w == r - 1` */
+
+    gps_buff_mark_t* marks;                     /*!< Side ring with receive times of sentence delimiters, `NULL` when not used */
+    size_t marks_size;                          /*!< Size of marks ring. Maximum number of marks is `1` less than value holds */
+    size_t mr;                                  /*!< Next read pointer of marks ring */
+    size_t mw;                                  /*!< Next write pointer of marks ring */
+#if GPS_CFG_PROTOCOL_UBX
+    uint16_t ubx_left;                          /*!< Bytes left in UBX frame being written, their values are not delimiters */
+    uint8_t ubx_state;                          /*!< Position of writer in UBX frame header, `0` outside of frame */
+#endif /* GPS_CFG_PROTOCOL_UBX */
+
+    gps_buff_waiter_t* waiter;                  /*!< Wait/notify backend, `NULL` when not used */
 } gps_buff_t;
 
 /* GPS Buffer Prototypes */
@@ -34,11 +97,23 @@ size_t      buff_write(gps_buff_t* buff, const void* data, size_t btw);
 size_t      buff_read(gps_buff_t* buff, void* data, size_t btr);
 size_t      buff_peek(gps_buff_t* buff, size_t skip_count, void* data, size_t btp);
 
+/* Receive time marks */
+uint8_t     buff_init_marks(gps_buff_t* buff, gps_buff_mark_t* marks, size_t count);
+size_t      buff_write_stamped(gps_buff_t* buff, const void* data, size_t btw, gps_tick_t ts);
+uint8_t     buff_mark_peek(gps_buff_t* buff, size_t* offset, gps_tick_t* ts);
+
+/* Wait/notify */
+uint8_t     buff_set_waiter(gps_buff_t* buff, gps_buff_waiter_t* waiter);
+size_t      buff_wait(gps_buff_t* buff, size_t min, uint32_t timeout_ms);
+size_t      buff_wait_eol(gps_buff_t* buff, uint32_t timeout_ms);
+uint8_t     buff_sleep_waiter_init(gps_buff_sleep_waiter_t* w, void (*sleep)(void));
+
 /* Buffer size information */
 size_t      buff_get_free(gps_buff_t* buff);
 size_t      buff_get_full(gps_buff_t* buff);
 
-
-
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
 
 #endif /* GPS_BUFF_H_ */
@@ -0,0 +1,192 @@
+/*
+ * gps_buff_posix.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ */
+
+#if defined(__linux__)
+
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE     200809L             /* clock_gettime, pthread_condattr_setclock */
+#endif
+
+#include "gps_buff_posix.h"
+
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+/**
+ * \brief           Get notification sequence of condition backend
+ */
+static uint32_t
+cond_prepare(gps_buff_waiter_t* w) {
+    gps_buff_cond_waiter_t* cw = (gps_buff_cond_waiter_t *)w;
+    uint32_t seq;
+
+    pthread_mutex_lock(&cw->mutex);
+    seq = cw->seq;
+    pthread_mutex_unlock(&cw->mutex);
+    return seq;
+}
+
+/**
+ * \brief           Wait on condition until sequence changes or timeout
+ */
+static uint8_t
+cond_wait(gps_buff_waiter_t* w, uint32_t seq, uint32_t timeout_ms) {
+    gps_buff_cond_waiter_t* cw = (gps_buff_cond_waiter_t *)w;
+    struct timespec ts;
+    uint8_t res;
+    int err = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    ts.tv_sec += timeout_ms / 1000;
+    ts.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&cw->mutex);
+    while (cw->seq == seq && err == 0) {        /* Timeout or error ends the wait, caller checks buffer */
+        if (timeout_ms == GPS_BUFF_WAIT_FOREVER) {
+            err = pthread_cond_wait(&cw->cond, &cw->mutex);
+        } else {
+            err = pthread_cond_timedwait(&cw->cond, &cw->mutex, &ts);
+        }
+    }
+    res = cw->seq != seq;
+    pthread_mutex_unlock(&cw->mutex);
+    return res;
+}
+
+/**
+ * \brief           Increment sequence and wake up all waiters
+ */
+static void
+cond_notify(gps_buff_waiter_t* w) {
+    gps_buff_cond_waiter_t* cw = (gps_buff_cond_waiter_t *)w;
+
+    pthread_mutex_lock(&cw->mutex);
+    cw->seq++;
+    pthread_cond_broadcast(&cw->cond);
+    pthread_mutex_unlock(&cw->mutex);
+}
+
+/**
+ * \brief           Initialize condition variable backend
+ * \param[in]       w: Backend to initialize
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+buff_cond_waiter_init(gps_buff_cond_waiter_t* w) {
+    pthread_condattr_t attr;
+
+    if (w == NULL) {
+        return 0;
+    }
+    if (pthread_mutex_init(&w->mutex, NULL) != 0) {
+        return 0;
+    }
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);  /* Timeouts immune to wall clock changes */
+    if (pthread_cond_init(&w->cond, &attr) != 0) {
+        pthread_condattr_destroy(&attr);
+        pthread_mutex_destroy(&w->mutex);
+        return 0;
+    }
+    pthread_condattr_destroy(&attr);
+    w->seq = 0;
+    w->ops.prepare = cond_prepare;
+    w->ops.wait = cond_wait;
+    w->ops.notify = cond_notify;
+    return 1;
+}
+
+/**
+ * \brief           Free condition variable backend
+ * \param[in]       w: Backend to free
+ */
+void
+buff_cond_waiter_free(gps_buff_cond_waiter_t* w) {
+    if (w != NULL) {
+        pthread_cond_destroy(&w->cond);
+        pthread_mutex_destroy(&w->mutex);
+    }
+}
+
+/**
+ * \brief           Event counter keeps notifications, nothing to take before check
+ */
+static uint32_t
+eventfd_prepare(gps_buff_waiter_t* w) {
+    (void)w;
+    return 0;
+}
+
+/**
+ * \brief           Wait until event file descriptor is readable, then clear it
+ */
+static uint8_t
+eventfd_wait(gps_buff_waiter_t* w, uint32_t seq, uint32_t timeout_ms) {
+    gps_buff_eventfd_waiter_t* ew = (gps_buff_eventfd_waiter_t *)w;
+    struct pollfd pfd;
+    uint64_t cnt;
+
+    (void)seq;
+    pfd.fd = ew->fd;
+    pfd.events = POLLIN;
+    if (poll(&pfd, 1, timeout_ms == GPS_BUFF_WAIT_FOREVER ? -1 : (int)timeout_ms) <= 0) {
+        return 0;
+    }
+    return read(ew->fd, &cnt, sizeof(cnt)) == (ssize_t)sizeof(cnt);
+}
+
+/**
+ * \brief           Add one to event counter
+ */
+static void
+eventfd_notify(gps_buff_waiter_t* w) {
+    uint64_t one = 1;
+
+    if (write(((gps_buff_eventfd_waiter_t *)w)->fd, &one, sizeof(one)) < 0) {
+        /* Counter overflow only, reader is already woken up */
+    }
+}
+
+/**
+ * \brief           Initialize `eventfd` backend
+ * \param[in]       w: Backend to initialize
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+buff_eventfd_waiter_init(gps_buff_eventfd_waiter_t* w) {
+    if (w == NULL) {
+        return 0;
+    }
+    w->fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (w->fd < 0) {
+        return 0;
+    }
+    w->ops.prepare = eventfd_prepare;
+    w->ops.wait = eventfd_wait;
+    w->ops.notify = eventfd_notify;
+    return 1;
+}
+
+/**
+ * \brief           Free `eventfd` backend
+ * \param[in]       w: Backend to free
+ */
+void
+buff_eventfd_waiter_free(gps_buff_eventfd_waiter_t* w) {
+    if (w != NULL && w->fd >= 0) {
+        close(w->fd);
+        w->fd = -1;
+    }
+}
+
+#endif /* defined(__linux__) */
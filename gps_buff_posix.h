@@ -0,0 +1,42 @@
+/*
+ * gps_buff_posix.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ */
+
+#ifndef GPS_BUFF_POSIX_H_
+#define GPS_BUFF_POSIX_H_
+
+#include "gps_buff.h"
+
+#if defined(__linux__)
+
+#include <pthread.h>
+
+/**
+ * \brief           Backend with condition variable, for reader and writer in different threads
+ */
+typedef struct {
+    gps_buff_waiter_t ops;                      /*!< Backend functions, must be first */
+    pthread_mutex_t mutex;                      /*!< Mutex protecting sequence */
+    pthread_cond_t cond;                        /*!< Condition signaled on every write */
+    uint32_t seq;                               /*!< Notification sequence */
+} gps_buff_cond_waiter_t;
+
+/**
+ * \brief           Backend with `eventfd`, reader can also wait for it with `poll` or `epoll`
+ */
+typedef struct {
+    gps_buff_waiter_t ops;                      /*!< Backend functions, must be first */
+    int fd;                                     /*!< Event file descriptor */
+} gps_buff_eventfd_waiter_t;
+
+uint8_t     buff_cond_waiter_init(gps_buff_cond_waiter_t* w);
+void        buff_cond_waiter_free(gps_buff_cond_waiter_t* w);
+uint8_t     buff_eventfd_waiter_init(gps_buff_eventfd_waiter_t* w);
+void        buff_eventfd_waiter_free(gps_buff_eventfd_waiter_t* w);
+
+#endif /* defined(__linux__) */
+
+#endif /* GPS_BUFF_POSIX_H_ */
@@ -0,0 +1,143 @@
+/*
+ * gps_extrap.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ */
+
+#include "gps_extrap.h"
+#include "gps_prof.h"
+
+#include <math.h>
+#include <string.h>
+
+#define EARTH_RADIUS        FLT(6371000.0)
+#define DEG_TO_RAD          FLT(0.017453292519943295)
+#define KNOTS_TO_M_S        FLT(0.514444)
+#define FLT(x)              ((gps_float_t)(x))
+
+/**
+ * \brief           Get seconds elapsed from state time, limited to extrapolation horizon
+ * \param[in]       x: Extrapolator handle
+ * \param[in]       now: Current time in units of ticks
+ * \param[out]      dt: Elapsed time in units of seconds
+ * \return          `1` when within horizon, `0` when limited
+ */
+static uint8_t
+elapsed(const gps_extrap_t* x, gps_tick_t now, gps_float_t* dt) {
+    *dt = FLT((gps_tick_t)(now - x->t)) * x->sec_per_tick + x->lag;
+    if (*dt > x->max_dt) {
+        *dt = x->max_dt;
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * \brief           Init extrapolator with default filter weights
+ * \param[in]       x: Extrapolator handle
+ */
+void
+gps_extrap_init(gps_extrap_t* x) {
+    memset(x, 0x00, sizeof(*x));
+    x->alpha = FLT(GPS_CFG_EXTRAP_ALPHA);
+    x->beta = FLT(GPS_CFG_EXTRAP_BETA);
+    x->max_dt = FLT(GPS_CFG_EXTRAP_MAX_DT);
+    x->epoch = GPS_EPOCH_NONE;
+}
+
+/**
+ * \brief           Correct state with new fix, once per epoch
+ * \param[in]       x: Extrapolator handle
+ * \param[in]       fix: Published values
+ * \param[in]       t: Receive time of fix, `fix->gga.rx_last` when available
+ * \return          `1` on success, `0` when fix has no valid position
+ */
+uint8_t
+gps_extrap_update(gps_extrap_t* x, const gps_fix_t* fix, gps_tick_t t) {
+    gps_float_t dt, k_lat, rn, re, ru, c;
+    uint32_t tps = gps_prof_ticks_per_sec();
+
+    if (!fix->gga.fix) {
+        return 0;
+    }
+    x->sec_per_tick = tps ? FLT(1) / FLT(tps) : FLT(0);
+    k_lat = FLT(1) / (EARTH_RADIUS * DEG_TO_RAD);     /* Degrees per meter */
+
+    dt = FLT((gps_tick_t)(t - x->t)) * x->sec_per_tick;
+    if (fix->gga.timed && x->epoch != GPS_EPOCH_NONE && fix->gga.dated == x->dated
+        && fix->gga.epoch > x->epoch && FLT(fix->gga.epoch - x->epoch) * FLT(1e-6) > x->max_dt) {
+        dt = 0;                                 /* Gap longer than tick counter period looks short in ticks */
+    }
+    if (!x->valid || dt <= 0 || dt > x->max_dt) {
+        x->latitude = fix->gga.latitude;        /* Restart from measurement */
+        x->longitude = fix->gga.longitude;
+        x->altitude = fix->gga.altitude;
+        x->vn = x->ve = x->vu = 0;
+    } else {
+        c = FLT(cos(x->latitude * DEG_TO_RAD));
+        rn = (fix->gga.latitude - x->latitude) / k_lat - x->vn * dt;    /* Residuals to prediction, in meters */
+        re = (fix->gga.longitude - x->longitude) * c / k_lat - x->ve * dt;
+        ru = fix->gga.altitude - x->altitude - x->vu * dt;
+
+        x->latitude = fix->gga.latitude - (1 - x->alpha) * rn * k_lat;
+        x->longitude = fix->gga.longitude - (1 - x->alpha) * re * k_lat / c;
+        x->altitude = fix->gga.altitude - (1 - x->alpha) * ru;
+        x->vn += x->beta * rn / dt;
+        x->ve += x->beta * re / dt;
+        x->vu += x->beta * ru / dt;
+    }
+    if (fix->rmc.is_valid) {                    /* Measured horizontal velocity is better than estimate */
+        c = FLT(fix->rmc.coarse) * DEG_TO_RAD;
+        x->vn = FLT(fix->rmc.speed) * KNOTS_TO_M_S * FLT(cos(c));
+        x->ve = FLT(fix->rmc.speed) * KNOTS_TO_M_S * FLT(sin(c));
+    }
+
+    /* Precompute rates in degrees, queries are then multiply and add only */
+    x->dlat = x->vn * k_lat;
+    x->dlon = x->ve * k_lat / FLT(cos(x->latitude * DEG_TO_RAD));
+    x->t = t;
+    x->epoch = fix->gga.timed ? fix->gga.epoch : GPS_EPOCH_NONE;
+    x->dated = fix->gga.dated;
+    x->valid = 1;
+    x->stale = 0;
+    return 1;
+}
+
+/**
+ * \brief           Get position extrapolated to current time
+ *
+ *                  Constant time without trigonometry, may be called from fast control loop.
+ *                  Call at least once per tick counter period, so age over horizon is seen before counter wraps
+ * \param[in]       x: Extrapolator handle
+ * \param[in]       now: Current time in units of ticks, \ref gps_prof_now
+ * \param[out]      lat: Latitude in degrees. Set to `NULL` if not used
+ * \param[out]      lon: Longitude in degrees. Set to `NULL` if not used
+ * \param[out]      alt: Altitude in meters. Set to `NULL` if not used
+ * \return          `1` on success, `0` when there is no fix yet or last fix is older than horizon
+ */
+uint8_t
+gps_extrap_get(gps_extrap_t* x, gps_tick_t now,
+                gps_float_t* lat, gps_float_t* lon, gps_float_t* alt) {
+    gps_float_t dt;
+    uint8_t fresh;
+
+    if (!x->valid) {
+        return 0;
+    }
+    fresh = !x->stale && elapsed(x, now, &dt);
+    if (!fresh) {                               /* Stays stale until next fix, also when tick counter wraps */
+        x->stale = 1;
+        dt = x->max_dt;
+    }
+    if (lat != NULL) {
+        *lat = x->latitude + x->dlat * dt;
+    }
+    if (lon != NULL) {
+        *lon = x->longitude + x->dlon * dt;
+    }
+    if (alt != NULL) {
+        *alt = x->altitude + x->vu * dt;
+    }
+    return fresh;
+}
@@ -0,0 +1,75 @@
+/*
+ * gps_extrap.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ */
+
+#ifndef GPS_EXTRAP_H_
+#define GPS_EXTRAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "gps.h"
+
+/**
+ * \brief           Default weight of position residual in alpha-beta filter, `1` to follow fixes exactly
+ */
+#ifndef GPS_CFG_EXTRAP_ALPHA
+#define GPS_CFG_EXTRAP_ALPHA                0.85
+#endif
+
+/**
+ * \brief           Default weight of velocity correction in alpha-beta filter
+ */
+#ifndef GPS_CFG_EXTRAP_BETA
+#define GPS_CFG_EXTRAP_BETA                 0.3
+#endif
+
+/**
+ * \brief           Default longest extrapolation in units of seconds.
+ *                  Older state is held at this horizon and reported as stale
+ */
+#ifndef GPS_CFG_EXTRAP_MAX_DT
+#define GPS_CFG_EXTRAP_MAX_DT               2.0
+#endif
+
+/**
+ * \brief           Position extrapolator, alpha-beta filter with constant velocity model.
+ *
+ *                  Horizontal velocity is taken from RMC speed and coarse when valid,
+ *                  vertical velocity is always estimated from altitude residuals.
+ *                  Update and query must not preempt each other
+ */
+typedef struct {
+    gps_float_t latitude;                       /*!< Filtered latitude at time `t`, in degrees */
+    gps_float_t longitude;                      /*!< Filtered longitude at time `t`, in degrees */
+    gps_float_t altitude;                       /*!< Filtered altitude at time `t`, in meters */
+    gps_float_t vn;                             /*!< Velocity towards north in units of m/s */
+    gps_float_t ve;                             /*!< Velocity towards east in units of m/s */
+    gps_float_t vu;                             /*!< Climb rate in units of m/s */
+    gps_float_t dlat;                           /*!< Latitude change per second of extrapolation, in degrees */
+    gps_float_t dlon;                           /*!< Longitude change per second of extrapolation, in degrees */
+    gps_float_t sec_per_tick;                   /*!< Length of clock tick in units of seconds */
+
+    gps_float_t alpha;                          /*!< Weight of position residual */
+    gps_float_t beta;                           /*!< Weight of velocity correction */
+    gps_float_t max_dt;                         /*!< Longest extrapolation in units of seconds */
+    gps_float_t lag;                            /*!< Time from fix epoch to receive time of its last byte, in seconds */
+
+    gps_epoch_t epoch;                          /*!< UTC epoch of last fix, detects gaps longer than tick counter period.
+                                                    \ref GPS_EPOCH_NONE when fix had no time */
+    gps_tick_t t;                               /*!< Receive time of last fix */
+    uint8_t dated;                              /*!< Set when `epoch` has date, epochs are compared only on same time base */
+    uint8_t valid;                              /*!< Set to `1` after first fix */
+    uint8_t stale;                              /*!< Set to `1` once state was queried older than horizon */
+} gps_extrap_t;
+
+/* GPS extrapolation prototypes */
+void        gps_extrap_init(gps_extrap_t* x);
+uint8_t     gps_extrap_update(gps_extrap_t* x, const gps_fix_t* fix, gps_tick_t t);
+uint8_t     gps_extrap_get(gps_extrap_t* x, gps_tick_t now,
+                gps_float_t* lat, gps_float_t* lon, gps_float_t* alt);
+
+#endif /* GPS_EXTRAP_H_ */
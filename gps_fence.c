@@ -0,0 +1,355 @@
+/*
+ * gps_fence.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ */
+
+#include "gps_fence.h"
+
+#include <math.h>
+#include <string.h>
+
+#define DEG_TO_RAD          0.017453292519943295
+#define METERS_PER_DEG      (6371008.8 * DEG_TO_RAD)
+#define GRID_MARGIN         1.0f                /* Grid is larger than zones by this margin, in meters */
+#define CELLS               (GPS_CFG_FENCE_GRID * GPS_CFG_FENCE_GRID)
+#define FAR                 3.0e38f
+
+GPS_STATIC_ASSERT(GPS_CFG_FENCE_ZONES <= 32, fence_zones);
+GPS_STATIC_ASSERT(GPS_CFG_FENCE_POOL <= 0xFFFF && GPS_CFG_FENCE_EDGES <= 0xFFFF, fence_pool);
+
+/**
+ * \brief           Get squared distance of point from edge
+ */
+static float
+edge_dist2(const gps_fence_edge_t* e, float px, float py) {
+    float dx = e->bx - e->ax, dy = e->by - e->ay;
+    float len2 = dx * dx + dy * dy;
+    float t = len2 > 0 ? ((px - e->ax) * dx + (py - e->ay) * dy) / len2 : 0;
+
+    t = t < 0 ? 0 : (t > 1 ? 1 : t);
+    dx = e->ax + t * dx - px;
+    dy = e->ay + t * dy - py;
+    return dx * dx + dy * dy;
+}
+
+/**
+ * \brief           Check if segment from `p` to `q` crosses edge.
+ *                  Touching points count on one side only, so parity stays correct at vertices
+ */
+static uint8_t
+edge_cross(const gps_fence_edge_t* e, float px, float py, float qx, float qy) {
+    float o1 = (e->bx - e->ax) * (py - e->ay) - (e->by - e->ay) * (px - e->ax);
+    float o2 = (e->bx - e->ax) * (qy - e->ay) - (e->by - e->ay) * (qx - e->ax);
+    float o3 = (qx - px) * (e->ay - py) - (qy - py) * (e->ax - px);
+    float o4 = (qx - px) * (e->by - py) - (qy - py) * (e->bx - px);
+    return (o1 > 0) != (o2 > 0) && (o3 > 0) != (o4 > 0);
+}
+
+/**
+ * \brief           Get smallest distance between edge and box
+ */
+static float
+box_min_dist(const gps_fence_edge_t* e, float x0, float y0, float x1, float y1) {
+    gps_fence_edge_t side;
+    float d, best = FAR, cx[4], cy[4], ex[2], ey[2];
+    uint8_t i;
+
+    if ((e->ax >= x0 && e->ax <= x1 && e->ay >= y0 && e->ay <= y1)
+        || (e->bx >= x0 && e->bx <= x1 && e->by >= y0 && e->by <= y1)) {
+        return 0;                               /* Vertex inside box */
+    }
+    cx[0] = x0; cy[0] = y0; cx[1] = x1; cy[1] = y0;
+    cx[2] = x1; cy[2] = y1; cx[3] = x0; cy[3] = y1;
+    for (i = 0; i < 4; i++) {                   /* Edge crossing box side */
+        side.ax = cx[i]; side.ay = cy[i];
+        side.bx = cx[(i + 1) & 3]; side.by = cy[(i + 1) & 3];
+        if (edge_cross(&side, e->ax, e->ay, e->bx, e->by)) {
+            return 0;
+        }
+        d = edge_dist2(e, cx[i], cy[i]);        /* Box corner to edge */
+        best = d < best ? d : best;
+    }
+    ex[0] = e->ax; ey[0] = e->ay; ex[1] = e->bx; ey[1] = e->by;
+    for (i = 0; i < 2; i++) {                   /* Vertex to box */
+        float dx = ex[i] < x0 ? x0 - ex[i] : (ex[i] > x1 ? ex[i] - x1 : 0);
+        float dy = ey[i] < y0 ? y0 - ey[i] : (ey[i] > y1 ? ey[i] - y1 : 0);
+        d = dx * dx + dy * dy;
+        best = d < best ? d : best;
+    }
+    return sqrtf(best);
+}
+
+/**
+ * \brief           Get largest distance between edge and any point of box.
+ *                  Distance to edge is convex, so maximum is at one of corners
+ */
+static float
+box_max_dist(const gps_fence_edge_t* e, float x0, float y0, float x1, float y1) {
+    float d, best = edge_dist2(e, x0, y0);
+
+    d = edge_dist2(e, x1, y0); best = d > best ? d : best;
+    d = edge_dist2(e, x1, y1); best = d > best ? d : best;
+    d = edge_dist2(e, x0, y1); best = d > best ? d : best;
+    return sqrtf(best);
+}
+
+/**
+ * \brief           Get bit mask of polygon zones containing point, by ray casting over all edges
+ */
+static uint32_t
+inside_all(const gps_fence_t* f, float px, float py) {
+    const gps_fence_edge_t* e;
+    uint32_t inside = 0;
+    uint16_t i;
+
+    for (i = 0; i < f->edge_count; i++) {
+        e = &f->edges[i];
+        if ((e->ay > py) != (e->by > py)
+            && px < e->ax + (py - e->ay) * (e->bx - e->ax) / (e->by - e->ay)) {
+            inside ^= 1UL << e->zone;
+        }
+    }
+    return inside;
+}
+
+/**
+ * \brief           Init empty geofence
+ * \param[in]       f: Geofence handle
+ * \param[in]       ref_lat: Reference latitude of local frame in degrees, for example launch pad
+ * \param[in]       ref_lon: Reference longitude of local frame in degrees
+ */
+void
+gps_fence_init(gps_fence_t* f, gps_float_t ref_lat, gps_float_t ref_lon) {
+    memset(f, 0x00, sizeof(*f));
+    f->ref_lat = ref_lat;
+    f->ref_lon = ref_lon;
+    f->ky = (float)METERS_PER_DEG;
+    f->kx = (float)(METERS_PER_DEG * cos(ref_lat * DEG_TO_RAD));
+}
+
+/**
+ * \brief           Add polygon zone. Index must be compiled again afterwards
+ * \param[in]       f: Geofence handle
+ * \param[in]       kind: Zone kind
+ * \param[in]       lat: Latitudes of vertices in degrees
+ * \param[in]       lon: Longitudes of vertices in degrees
+ * \param[in]       n: Number of vertices, at least `3`. Polygon is closed automatically
+ * \param[out]      id: Zone index. Set to `NULL` if not used
+ * \return          `1` on success, `0` when zones or edges are full
+ */
+uint8_t
+gps_fence_add_polygon(gps_fence_t* f, gps_fence_kind_t kind, const gps_float_t* lat,
+                const gps_float_t* lon, size_t n, uint8_t* id) {
+    gps_fence_zone_t* z;
+    gps_fence_edge_t* e;
+    size_t i, j;
+
+    if (n < 3 || f->zone_count >= GPS_CFG_FENCE_ZONES || f->edge_count + n > GPS_CFG_FENCE_EDGES) {
+        return 0;
+    }
+    z = &f->zones[f->zone_count];
+    memset(z, 0x00, sizeof(*z));
+    z->kind = (uint8_t)kind;
+    z->edge = f->edge_count;
+    z->edges = (uint16_t)n;
+    for (i = 0; i < n; i++) {
+        j = (i + 1) % n;
+        e = &f->edges[f->edge_count++];
+        e->ax = (float)((lon[i] - f->ref_lon) * f->kx);
+        e->ay = (float)((lat[i] - f->ref_lat) * f->ky);
+        e->bx = (float)((lon[j] - f->ref_lon) * f->kx);
+        e->by = (float)((lat[j] - f->ref_lat) * f->ky);
+        e->zone = f->zone_count;
+    }
+    f->polygons |= 1UL << f->zone_count;
+    if (kind == GPS_FENCE_KEEP_IN) {
+        f->keep_in |= 1UL << f->zone_count;
+    }
+    if (id != NULL) {
+        *id = f->zone_count;
+    }
+    f->zone_count++;
+    f->compiled = 0;
+    return 1;
+}
+
+/**
+ * \brief           Add circle zone. Index must be compiled again afterwards
+ * \param[in]       f: Geofence handle
+ * \param[in]       kind: Zone kind
+ * \param[in]       lat: Latitude of center in degrees
+ * \param[in]       lon: Longitude of center in degrees
+ * \param[in]       radius: Radius in meters
+ * \param[out]      id: Zone index. Set to `NULL` if not used
+ * \return          `1` on success, `0` when zones are full
+ */
+uint8_t
+gps_fence_add_circle(gps_fence_t* f, gps_fence_kind_t kind, gps_float_t lat,
+                gps_float_t lon, gps_float_t radius, uint8_t* id) {
+    gps_fence_zone_t* z;
+
+    if (radius <= 0 || f->zone_count >= GPS_CFG_FENCE_ZONES) {
+        return 0;
+    }
+    z = &f->zones[f->zone_count];
+    memset(z, 0x00, sizeof(*z));
+    z->kind = (uint8_t)kind;
+    z->cx = (float)((lon - f->ref_lon) * f->kx);
+    z->cy = (float)((lat - f->ref_lat) * f->ky);
+    z->r = (float)radius;
+    if (kind == GPS_FENCE_KEEP_IN) {
+        f->keep_in |= 1UL << f->zone_count;
+    }
+    if (id != NULL) {
+        *id = f->zone_count;
+    }
+    f->zone_count++;
+    f->compiled = 0;
+    return 1;
+}
+
+/**
+ * \brief           Build grid index of polygon edges
+ *
+ *                  Each cell lists edges crossing it and all edges which may be nearest
+ *                  to any point of cell, together with zones containing its center.
+ *                  Check then needs only edges of one cell
+ * \param[in]       f: Geofence handle
+ * \return          `1` on success, `0` when edge references do not fit \ref GPS_CFG_FENCE_POOL
+ */
+uint8_t
+gps_fence_compile(gps_fence_t* f) {
+    float xmin = FAR, ymin = FAR, xmax = -FAR, ymax = -FAR, bx0, by0, bx1, by1, lim, d;
+    gps_fence_cell_t* c;
+    size_t used = 0, i;
+    uint16_t k;
+
+    f->compiled = 0;
+    f->max_refs = 0;
+    for (k = 0; k < f->edge_count; k++) {       /* Bounding box of polygons */
+        const gps_fence_edge_t* e = &f->edges[k];
+        xmin = e->ax < xmin ? e->ax : xmin; xmax = e->ax > xmax ? e->ax : xmax;
+        ymin = e->ay < ymin ? e->ay : ymin; ymax = e->ay > ymax ? e->ay : ymax;
+    }
+    if (f->edge_count == 0) {
+        xmin = ymin = xmax = ymax = 0;
+    }
+    f->x0 = xmin - GRID_MARGIN;
+    f->y0 = ymin - GRID_MARGIN;
+    f->cw = (xmax - xmin + 2 * GRID_MARGIN) / GPS_CFG_FENCE_GRID;
+    f->ch = (ymax - ymin + 2 * GRID_MARGIN) / GPS_CFG_FENCE_GRID;
+
+    for (i = 0; i < CELLS; i++) {
+        c = &f->cells[i];
+        bx0 = f->x0 + (float)(i % GPS_CFG_FENCE_GRID) * f->cw;
+        by0 = f->y0 + (float)(i / GPS_CFG_FENCE_GRID) * f->ch;
+        bx1 = bx0 + f->cw;
+        by1 = by0 + f->ch;
+        c->inside = inside_all(f, (bx0 + bx1) * 0.5f, (by0 + by1) * 0.5f);
+        c->first = (uint16_t)used;
+        c->count = 0;
+
+        lim = FAR;                              /* Nearest edge of any point in cell is not farther than this */
+        for (k = 0; k < f->edge_count; k++) {
+            d = box_max_dist(&f->edges[k], bx0, by0, bx1, by1);
+            lim = d < lim ? d : lim;
+        }
+        for (k = 0; k < f->edge_count; k++) {
+            if (box_min_dist(&f->edges[k], bx0, by0, bx1, by1) <= lim) {
+                if (used >= GPS_CFG_FENCE_POOL) {
+                    return 0;
+                }
+                f->pool[used++] = k;
+                c->count++;
+            }
+        }
+        f->max_refs = c->count > f->max_refs ? c->count : f->max_refs;
+    }
+    f->compiled = 1;
+    return 1;
+}
+
+/**
+ * \brief           Check position against all zones
+ *
+ *                  Inside grid, time is bounded by number of circles and `max_refs` edges of one cell.
+ *                  Outside grid the position is outside all polygons, but any edge may be nearest,
+ *                  so all `edge_count` edges are scanned and time is bounded by \ref GPS_CFG_FENCE_EDGES only.
+ *                  Grid spans all polygons, keep-in polygon around flight area keeps check within `max_refs`
+ * \param[in]       f: Geofence handle, compiled
+ * \param[in]       lat: Latitude in degrees
+ * \param[in]       lon: Longitude in degrees
+ * \param[out]      res: Check result
+ * \return          `1` on success, `0` when index is not compiled
+ */
+uint8_t
+gps_fence_check(const gps_fence_t* f, gps_float_t lat, gps_float_t lon, gps_fence_result_t* res) {
+    const gps_fence_cell_t* c;
+    const gps_fence_edge_t* e;
+    float px, py, d, best = FAR, cx, cy;
+    uint32_t inside = 0;
+    int32_t gx, gy;
+    uint16_t k;
+    uint8_t i, nearest = 0xFF;
+
+    if (!f->compiled) {
+        return 0;
+    }
+    px = (float)((lon - f->ref_lon) * f->kx);
+    py = (float)((lat - f->ref_lat) * f->ky);
+
+    for (i = 0; i < f->zone_count; i++) {       /* Circles are checked directly */
+        const gps_fence_zone_t* z = &f->zones[i];
+        if (z->r > 0) {
+            d = sqrtf((px - z->cx) * (px - z->cx) + (py - z->cy) * (py - z->cy)) - z->r;
+            if (d < 0) {
+                inside |= 1UL << i;
+                d = -d;
+            }
+            if (d < best) {
+                best = d;
+                nearest = i;
+            }
+        }
+    }
+
+    best *= best;                               /* Edges compare squared distances */
+    gx = (int32_t)floorf((px - f->x0) / f->cw);
+    gy = (int32_t)floorf((py - f->y0) / f->ch);
+    if (gx >= 0 && gx < GPS_CFG_FENCE_GRID && gy >= 0 && gy < GPS_CFG_FENCE_GRID) {
+        c = &f->cells[gy * GPS_CFG_FENCE_GRID + gx];
+        cx = f->x0 + ((float)gx + 0.5f) * f->cw;
+        cy = f->y0 + ((float)gy + 0.5f) * f->ch;
+        inside |= c->inside;
+        for (k = 0; k < c->count; k++) {
+            e = &f->edges[f->pool[c->first + k]];
+            if (edge_cross(e, px, py, cx, cy)) {    /* Each crossing to cell center flips containment */
+                inside ^= 1UL << e->zone;
+            }
+            d = edge_dist2(e, px, py);
+            if (d < best) {
+                best = d;
+                nearest = e->zone;
+            }
+        }
+    } else {                                    /* Outside of grid, so outside of all polygons. Not bounded by `max_refs` */
+        for (k = 0; k < f->edge_count; k++) {
+            d = edge_dist2(&f->edges[k], px, py);
+            if (d < best) {
+                best = d;
+                nearest = f->edges[k].zone;
+            }
+        }
+    }
+
+    res->dist = sqrtf(best);
+    res->inside = inside;
+    res->violated = inside & ~f->keep_in;       /* Inside of keep-out zones */
+    if (f->keep_in && !(inside & f->keep_in)) {
+        res->violated |= f->keep_in;
+    }
+    res->nearest = nearest;
+    return 1;
+}
@@ -0,0 +1,132 @@
+/*
+ * gps_fence.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ */
+
+#ifndef GPS_FENCE_H_
+#define GPS_FENCE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "gps.h"
+
+/**
+ * \brief           Maximum number of zones, up to `32`
+ */
+#ifndef GPS_CFG_FENCE_ZONES
+#define GPS_CFG_FENCE_ZONES                 8
+#endif
+
+/**
+ * \brief           Maximum number of polygon edges of all zones
+ */
+#ifndef GPS_CFG_FENCE_EDGES
+#define GPS_CFG_FENCE_EDGES                 64
+#endif
+
+/**
+ * \brief           Number of grid cells per side of index
+ */
+#ifndef GPS_CFG_FENCE_GRID
+#define GPS_CFG_FENCE_GRID                  8
+#endif
+
+/**
+ * \brief           Number of edge references of all grid cells
+ */
+#ifndef GPS_CFG_FENCE_POOL
+#define GPS_CFG_FENCE_POOL                  1024
+#endif
+
+/**
+ * \brief           Zone kind
+ */
+typedef enum {
+    GPS_FENCE_KEEP_IN = 0,                      /*!< Vehicle must stay inside one of keep-in zones */
+    GPS_FENCE_KEEP_OUT,                         /*!< Vehicle must stay outside of zone */
+} gps_fence_kind_t;
+
+/**
+ * \brief           Zone, polygon or circle, in local frame
+ */
+typedef struct {
+    float cx;                                   /*!< Circle center east of reference, in meters */
+    float cy;                                   /*!< Circle center north of reference, in meters */
+    float r;                                    /*!< Circle radius in meters, `0` for polygon */
+    uint16_t edge;                              /*!< Index of first polygon edge */
+    uint16_t edges;                             /*!< Number of polygon edges */
+    uint8_t kind;                               /*!< Zone kind, \ref gps_fence_kind_t */
+} gps_fence_zone_t;
+
+/**
+ * \brief           Polygon edge in local frame, in meters
+ */
+typedef struct {
+    float ax, ay;                               /*!< First vertex */
+    float bx, by;                               /*!< Second vertex */
+    uint8_t zone;                               /*!< Zone index */
+} gps_fence_edge_t;
+
+/**
+ * \brief           Grid cell of index
+ */
+typedef struct {
+    uint32_t inside;                            /*!< Bit mask of polygon zones containing cell center */
+    uint16_t first;                             /*!< Index of first edge reference in pool */
+    uint16_t count;                             /*!< Number of edge references, edges crossing cell
+                                                    and all edges which may be nearest to point in cell */
+} gps_fence_cell_t;
+
+/**
+ * \brief           Result of fence check
+ */
+typedef struct {
+    float dist;                                 /*!< Distance to nearest zone boundary in meters */
+    uint32_t inside;                            /*!< Bit mask of zones containing position */
+    uint32_t violated;                          /*!< Bit mask of violated zones. Keep-in zones are
+                                                    violated together when position is outside all of them */
+    uint8_t nearest;                            /*!< Index of zone with nearest boundary */
+} gps_fence_result_t;
+
+/**
+ * \brief           Geofence with static grid index.
+ *
+ *                  Positions are projected to local plane around reference point,
+ *                  which is accurate for ranges of tens of kilometers
+ */
+typedef struct {
+    gps_float_t ref_lat;                        /*!< Reference latitude in degrees */
+    gps_float_t ref_lon;                        /*!< Reference longitude in degrees */
+    float kx;                                   /*!< Meters per degree of longitude */
+    float ky;                                   /*!< Meters per degree of latitude */
+
+    gps_fence_zone_t zones[GPS_CFG_FENCE_ZONES];    /*!< Zones */
+    gps_fence_edge_t edges[GPS_CFG_FENCE_EDGES];    /*!< Polygon edges of all zones */
+    uint8_t zone_count;                         /*!< Number of zones */
+    uint16_t edge_count;                        /*!< Number of edges */
+    uint32_t keep_in;                           /*!< Bit mask of keep-in zones */
+    uint32_t polygons;                          /*!< Bit mask of polygon zones */
+
+    float x0, y0;                               /*!< Lower left corner of grid, in meters */
+    float cw, ch;                               /*!< Cell width and height, in meters */
+    gps_fence_cell_t cells[GPS_CFG_FENCE_GRID * GPS_CFG_FENCE_GRID];    /*!< Grid cells */
+    uint16_t pool[GPS_CFG_FENCE_POOL];          /*!< Edge references of cells */
+    uint16_t max_refs;                          /*!< Largest number of edge references of one cell, bounds check time inside grid */
+    uint8_t compiled;                           /*!< Set to `1` when index is valid */
+} gps_fence_t;
+
+/* Building, done once before flight */
+void        gps_fence_init(gps_fence_t* f, gps_float_t ref_lat, gps_float_t ref_lon);
+uint8_t     gps_fence_add_polygon(gps_fence_t* f, gps_fence_kind_t kind, const gps_float_t* lat,
+                const gps_float_t* lon, size_t n, uint8_t* id);
+uint8_t     gps_fence_add_circle(gps_fence_t* f, gps_fence_kind_t kind, gps_float_t lat,
+                gps_float_t lon, gps_float_t radius, uint8_t* id);
+uint8_t     gps_fence_compile(gps_fence_t* f);
+
+/* Check, bounded time inside grid, see \ref gps_fence_check */
+uint8_t     gps_fence_check(const gps_fence_t* f, gps_float_t lat, gps_float_t lon, gps_fence_result_t* res);
+
+#endif /* GPS_FENCE_H_ */
@@ -0,0 +1,327 @@
+/*
+ * gps_fusion.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ */
+
+#include "gps_fusion.h"
+
+#include <math.h>
+#include <string.h>
+
+#define LATE_US             60000000ULL         /* Older keys are taken as time jump of receiver, not late epoch */
+#define US_PER_DAY          86400000000ULL
+#define EARTH_RADIUS        FLT(6371000.0)
+#define DEG_TO_RAD          FLT(0.017453292519943295)
+#define HDOP_UNKNOWN        FLT(20.0)           /* Used for weight when receiver does not report HDOP */
+#define HDOP_MIN            FLT(0.5)            /* Limits weight of single receiver */
+#define FLT(x)              ((gps_float_t)(x))
+
+GPS_STATIC_ASSERT(GPS_CFG_FUSION_RECEIVERS <= 8, fusion_mask);
+
+/**
+ * \brief           Get time key of `GGA` values.
+ *                  Key is time of day, so dated and undated receivers report same epoch
+ * \param[in]       gga: `GGA` values
+ * \return          Time of day of epoch in units of microseconds,
+ *                  \ref GPS_EPOCH_NONE when statement had no time
+ */
+static gps_epoch_t
+time_key(const gps_gga_t* gga) {
+    return gga->timed ? gga->epoch % US_PER_DAY : GPS_EPOCH_NONE;
+}
+
+/**
+ * \brief           Check if time key belongs to same or recent earlier epoch, across midnight
+ * \param[in]       k: Time key to check
+ * \param[in]       ref: Reference time key
+ * \return          `1` when `k` is not later than `ref`, `0` otherwise
+ */
+static uint8_t
+key_late(gps_epoch_t k, gps_epoch_t ref) {
+    return (ref + US_PER_DAY - k) % US_PER_DAY <= LATE_US;
+}
+
+/**
+ * \brief           Get quality rank of fix type, higher is better
+ * \param[in]       fix: Fix type of `GGA` statement
+ * \return          Rank, `0` for invalid fix
+ */
+static uint8_t
+fix_rank(uint8_t fix) {
+    /* Invalid, GPS, DGPS, PPS, RTK fixed, RTK float, dead reckoning */
+    static const uint8_t rank[] = { 0, 2, 3, 3, 5, 4, 1 };
+    return fix < sizeof(rank) ? rank[fix] : 0;
+}
+
+/**
+ * \brief           Get horizontal dilution used for ranking and weighting
+ * \param[in]       g: Values of receiver
+ * \return          HDOP, pDOP of UBX receiver when HDOP is not reported (never lower than HDOP)
+ *                  or \ref HDOP_UNKNOWN
+ */
+static gps_float_t
+fix_hdop(const gps_gga_t* g) {
+    if (g->hdop > 0) {
+        return FLT(g->hdop);
+    }
+#if GPS_CFG_PROTOCOL_UBX
+    if (g->pdop > 0) {
+        return FLT(g->pdop);
+    }
+#endif /* GPS_CFG_PROTOCOL_UBX */
+    return HDOP_UNKNOWN;
+}
+
+/**
+ * \brief           Compare quality of two fixes by fix type, satellites in use and HDOP
+ * \param[in]       a: First values
+ * \param[in]       b: Second values
+ * \return          `1` when `a` is better than `b`, `0` otherwise
+ */
+static uint8_t
+fix_better(const gps_gga_t* a, const gps_gga_t* b) {
+    uint8_t ra = fix_rank(a->fix), rb = fix_rank(b->fix);
+
+    if (ra != rb) {
+        return ra > rb;
+    }
+    if (a->sats_in_use != b->sats_in_use) {
+        return a->sats_in_use > b->sats_in_use;
+    }
+    return fix_hdop(a) < fix_hdop(b);
+}
+
+/**
+ * \brief           Get longitude difference wrapped to `-180` to `180` degrees
+ */
+static gps_float_t
+lon_diff(gps_float_t a, gps_float_t b) {
+    gps_float_t d = a - b;
+    if (d > FLT(180)) {
+        d -= FLT(360);
+    } else if (d < FLT(-180)) {
+        d += FLT(360);
+    }
+    return d;
+}
+
+/**
+ * \brief           Publish pending epoch to output
+ * \param[in]       f: Fusion handle
+ */
+static void
+emit(gps_fusion_t* f) {
+    gps_fusion_out_t* o = &f->out;
+    const gps_gga_t* best;
+    gps_float_t w, wsum, lat, lon, alt, geo, coslat, dx, dy, dh, da;
+    uint8_t i, src = 0xFF, n;
+
+    for (i = 0; i < f->count; i++) {            /* Find best receiver of epoch */
+        if (!(f->mask & (1U << i))) {
+            f->miss[i] += f->miss[i] < 0xFF;
+            continue;
+        }
+        f->miss[i] = 0;
+        if (src == 0xFF || fix_better(&f->fix[i].gga, &f->fix[src].gga)) {
+            src = i;
+        }
+    }
+
+    best = &f->fix[src].gga;
+    memset(o, 0x00, sizeof(*o));
+    gps_get_fix(f->rx[src], &o->fix);           /* Take latest RMC values of source */
+    o->fix.gga = *best;
+    o->used = f->mask;
+    o->source = src;
+    for (i = 0; i < f->count && !o->fix.gga.dated; i++) {  /* Epoch of dated receiver when source has no date */
+        if ((f->mask & (1U << i)) && f->fix[i].gga.dated) {
+            o->fix.gga.epoch = f->fix[i].gga.epoch;
+            o->fix.gga.dated = 1;
+        }
+    }
+
+    /* Compare valid receivers against best one, equirectangular distance is enough for meters */
+    coslat = FLT(cos(best->latitude * DEG_TO_RAD));
+    wsum = lat = lon = alt = geo = FLT(0);
+    n = 0;
+    for (i = 0; best->fix && i < f->count; i++) {
+        const gps_gga_t* g = &f->fix[i].gga;
+        if (!(f->mask & (1U << i)) || !g->fix) {
+            continue;
+        }
+        dy = (g->latitude - best->latitude) * DEG_TO_RAD * EARTH_RADIUS;
+        dx = lon_diff(g->longitude, best->longitude) * DEG_TO_RAD * EARTH_RADIUS * coslat;
+        dh = FLT(sqrt(dx * dx + dy * dy));
+        da = FLT(fabs(g->altitude - best->altitude));
+        o->sep = dh > o->sep ? dh : o->sep;
+        o->alt_diff = da > o->alt_diff ? da : o->alt_diff;
+
+        if (f->blend && fix_rank(g->fix) == fix_rank(best->fix)
+            && dh <= f->max_sep && da <= f->max_alt) {
+            w = fix_hdop(g);
+            w = w < HDOP_MIN ? HDOP_MIN : w;
+            w = FLT(1) / (w * w);               /* Weight by inverse variance */
+            wsum += w;
+            lat += w * (g->latitude - best->latitude);
+            lon += w * lon_diff(g->longitude, best->longitude);
+            alt += w * (g->altitude - best->altitude);
+            geo += w * (g->geo_sep - best->geo_sep);
+            n++;
+        }
+    }
+    o->disagree = o->sep > f->max_sep || o->alt_diff > f->max_alt;
+
+    if (n > 1 && !o->disagree) {                /* Average offsets from best receiver */
+        o->fix.gga.latitude += lat / wsum;
+        o->fix.gga.longitude = best->longitude + lon / wsum;
+        if (o->fix.gga.longitude > FLT(180)) {
+            o->fix.gga.longitude -= FLT(360);
+        } else if (o->fix.gga.longitude < FLT(-180)) {
+            o->fix.gga.longitude += FLT(360);
+        }
+        o->fix.gga.altitude += (gps_aux_float_t)(alt / wsum);
+        o->fix.gga.geo_sep += (gps_aux_float_t)(geo / wsum);
+        o->blended = 1;
+    }
+
+    f->last_key = f->key;
+    f->has_last = 1;
+    f->mask = 0;
+    f->ready = 1;
+}
+
+/**
+ * \brief           Check if all receivers still reporting have values of pending epoch
+ * \param[in]       f: Fusion handle
+ * \return          `1` when epoch is complete, `0` otherwise
+ */
+static uint8_t
+complete(gps_fusion_t* f) {
+    uint8_t expect = 0, i;
+
+    for (i = 0; i < f->count; i++) {            /* Do not wait for receivers which stopped reporting */
+        if (f->miss[i] < GPS_CFG_FUSION_MISS_LIMIT) {
+            expect |= (uint8_t)(1U << i);
+        }
+    }
+    return f->mask && (f->mask & expect) == expect;
+}
+
+/**
+ * \brief           Add new `GGA` values of receiver to pending epoch
+ * \param[in]       f: Fusion handle
+ * \param[in]       i: Receiver index
+ * \param[in]       k: Time key of values
+ * \param[in]       fix: Values of receiver
+ */
+static void
+add(gps_fusion_t* f, uint8_t i, gps_epoch_t k, const gps_fix_t* fix) {
+    if (f->has_last && key_late(k, f->last_key)) {
+        f->miss[i] = 0;                         /* Too late for published epoch, but alive */
+        return;
+    }
+    if (f->mask && k != f->key) {
+        if (key_late(k, f->key)) {
+            return;
+        }
+        emit(f);                                /* Receiver moved on, publish what we have */
+    }
+    if (!f->mask) {
+        f->key = k;
+    }
+    f->fix[i] = *fix;
+    f->mask |= (uint8_t)(1U << i);
+}
+
+/**
+ * \brief           Init fusion stage
+ * \param[in]       f: Fusion handle
+ * \param[in]       rx: Array of receiver handles, processed by application.
+ *                      Handles must be initialized already
+ * \param[in]       count: Number of receivers, up to \ref GPS_CFG_FUSION_RECEIVERS
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gps_fusion_init(gps_fusion_t* f, gps_t* const* rx, uint8_t count) {
+    uint8_t i;
+
+    if (f == NULL || rx == NULL || count == 0 || count > GPS_CFG_FUSION_RECEIVERS) {
+        return 0;
+    }
+    memset(f, 0x00, sizeof(*f));
+    for (i = 0; i < count; i++) {
+        gps_fix_t fix;
+        f->rx[i] = rx[i];
+        gps_get_fix(rx[i], &fix);
+        f->seen[i] = time_key(&fix.gga);        /* Values already present are not new epoch */
+    }
+    f->count = count;
+    f->max_sep = FLT(GPS_CFG_FUSION_MAX_SEP);
+    f->max_alt = FLT(GPS_CFG_FUSION_MAX_ALT);
+    f->blend = 1;
+    return 1;
+}
+
+/**
+ * \brief           Collect new values of receivers and publish epoch when complete
+ *
+ *                  Call after received data of any receiver were processed, until it returns `0`.
+ *                  Epoch is complete when all receivers reported it or when one of them
+ *                  reported later epoch already. Receivers which missed
+ *                  \ref GPS_CFG_FUSION_MISS_LIMIT epochs are not waited for
+ * \param[in]       f: Fusion handle
+ * \param[out]      out: Fused values of completed epoch
+ * \return          `1` when new epoch was published to `out`, `0` otherwise
+ */
+uint8_t
+gps_fusion_update(gps_fusion_t* f, gps_fusion_out_t* out) {
+    gps_fix_t fix;
+    gps_epoch_t k;
+    uint8_t i;
+
+    for (i = 0; i < f->count && !f->ready; i++) {  /* Rest is collected on next call */
+        gps_get_fix(f->rx[i], &fix);
+        k = time_key(&fix.gga);
+        if (k != f->seen[i]) {                  /* New GGA values of receiver */
+            f->seen[i] = k;
+            if (k != GPS_EPOCH_NONE) {          /* Values without time belong to no epoch */
+                add(f, i, k, &fix);
+            }
+        }
+    }
+    if (!f->ready && complete(f)) {
+        emit(f);
+    }
+    if (f->ready) {
+        f->ready = 0;
+        if (out != NULL) {
+            *out = f->out;
+        }
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Publish pending epoch without waiting for remaining receivers.
+ *                  Unread epoch already published is returned first
+ * \param[in]       f: Fusion handle
+ * \param[out]      out: Fused values of pending epoch
+ * \return          `1` when epoch was published to `out`, `0` when nothing was pending
+ */
+uint8_t
+gps_fusion_flush(gps_fusion_t* f, gps_fusion_out_t* out) {
+    if (!f->ready) {
+        if (!f->mask) {
+            return 0;
+        }
+        emit(f);
+    }
+    f->ready = 0;
+    if (out != NULL) {
+        *out = f->out;
+    }
+    return 1;
+}
@@ -0,0 +1,89 @@
+/*
+ * gps_fusion.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ */
+
+#ifndef GPS_FUSION_H_
+#define GPS_FUSION_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "gps.h"
+
+/**
+ * \brief           Maximum number of receivers feeding one fusion stage, up to `8`
+ */
+#ifndef GPS_CFG_FUSION_RECEIVERS
+#define GPS_CFG_FUSION_RECEIVERS            2
+#endif
+
+/**
+ * \brief           Number of consecutive missed epochs after which receiver is not waited for.
+ *                  Epoch is then published as soon as remaining receivers report it
+ */
+#ifndef GPS_CFG_FUSION_MISS_LIMIT
+#define GPS_CFG_FUSION_MISS_LIMIT           2
+#endif
+
+/**
+ * \brief           Default horizontal distance between receivers in units of meters,
+ *                  above which they are considered to disagree
+ */
+#ifndef GPS_CFG_FUSION_MAX_SEP
+#define GPS_CFG_FUSION_MAX_SEP              25.0
+#endif
+
+/**
+ * \brief           Default altitude difference between receivers in units of meters,
+ *                  above which they are considered to disagree
+ */
+#ifndef GPS_CFG_FUSION_MAX_ALT
+#define GPS_CFG_FUSION_MAX_ALT              50.0
+#endif
+
+/**
+ * \brief           Result of one fused epoch
+ */
+typedef struct {
+    gps_fix_t fix;                              /*!< Values of best receiver, position blended when `blended` is set */
+    gps_float_t sep;                            /*!< Largest horizontal distance of valid receiver from best one, in meters */
+    gps_float_t alt_diff;                       /*!< Largest altitude difference of valid receiver from best one, in meters */
+    uint8_t used;                               /*!< Bit mask of receivers which reported this epoch */
+    uint8_t source;                             /*!< Index of best receiver */
+    uint8_t blended;                            /*!< Set to `1` when position is weighted average of several receivers */
+    uint8_t disagree;                           /*!< Set to `1` when valid receivers differ more than allowed */
+} gps_fusion_out_t;
+
+/**
+ * \brief           Fusion stage of redundant receivers.
+ *                  Epochs are aligned by UTC time of day of `GGA` values, so receivers
+ *                  which did not get date from `RMC` yet are fused with those which did
+ */
+typedef struct {
+    gps_t* rx[GPS_CFG_FUSION_RECEIVERS];        /*!< Receiver handles */
+    gps_fix_t fix[GPS_CFG_FUSION_RECEIVERS];    /*!< Values of pending epoch per receiver */
+    gps_epoch_t seen[GPS_CFG_FUSION_RECEIVERS]; /*!< Time key of last `GGA` values seen per receiver */
+    uint8_t miss[GPS_CFG_FUSION_RECEIVERS];     /*!< Number of consecutive epochs missed per receiver */
+    uint8_t count;                              /*!< Number of receivers */
+
+    gps_float_t max_sep;                        /*!< Disagreement threshold of horizontal distance, in meters */
+    gps_float_t max_alt;                        /*!< Disagreement threshold of altitude difference, in meters */
+    uint8_t blend;                              /*!< Set to `1` to average position of equally good receivers */
+
+    gps_epoch_t key;                            /*!< Time key of pending epoch */
+    gps_epoch_t last_key;                       /*!< Time key of last published epoch */
+    uint8_t has_last;                           /*!< Set to `1` when `last_key` is valid */
+    uint8_t mask;                               /*!< Bit mask of receivers which reported pending epoch */
+    uint8_t ready;                              /*!< Set to `1` when `out` holds unread epoch */
+    gps_fusion_out_t out;                       /*!< Last published epoch */
+} gps_fusion_t;
+
+/* GPS fusion prototypes */
+uint8_t     gps_fusion_init(gps_fusion_t* f, gps_t* const* rx, uint8_t count);
+uint8_t     gps_fusion_update(gps_fusion_t* f, gps_fusion_out_t* out);
+uint8_t     gps_fusion_flush(gps_fusion_t* f, gps_fusion_out_t* out);
+
+#endif /* GPS_FUSION_H_ */
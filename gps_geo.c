@@ -0,0 +1,274 @@
+/*
+ * gps_geo.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ */
+
+#include "gps_geo.h"
+
+#include <math.h>
+
+#define FLT(x)              ((gps_float_t)(x))
+#define DEG_TO_RAD          FLT(0.017453292519943295)
+#define RAD_TO_DEG          FLT(57.29577951308232)
+#define EARTH_RADIUS        FLT(6371008.8)      /* Mean radius for spherical formulas */
+#define WGS84_A             FLT(6378137.0)      /* Semi-major axis */
+#define WGS84_F             FLT(1.0 / 298.257223563)
+#define WGS84_B             (WGS84_A * (1 - WGS84_F))
+#define WGS84_E2            (WGS84_F * (2 - WGS84_F))
+#define HALF_PI             FLT(1.5707963267948966)
+#define VINCENTY_ITER       200
+#define VINCENTY_EPS        FLT(1e-12)
+
+/**
+ * \brief           Init reference point of local frame
+ * \param[in]       ref: Reference point
+ * \param[in]       lat: Latitude in degrees
+ * \param[in]       lon: Longitude in degrees
+ * \param[in]       alt: Altitude in meters
+ */
+void
+gps_geo_ref_init(gps_geo_ref_t* ref, gps_float_t lat, gps_float_t lon, gps_float_t alt) {
+    gps_float_t nr;
+
+    ref->latitude = lat;
+    ref->longitude = lon;
+    ref->altitude = alt;
+    ref->sin_lat = FLT(sin(lat * DEG_TO_RAD));
+    ref->cos_lat = FLT(cos(lat * DEG_TO_RAD));
+    ref->sin_lon = FLT(sin(lon * DEG_TO_RAD));
+    ref->cos_lon = FLT(cos(lon * DEG_TO_RAD));
+
+    nr = WGS84_A / FLT(sqrt(1 - WGS84_E2 * ref->sin_lat * ref->sin_lat));
+    ref->x = (nr + alt) * ref->cos_lat * ref->cos_lon;
+    ref->y = (nr + alt) * ref->cos_lat * ref->sin_lon;
+    ref->z = (nr * (1 - WGS84_E2) + alt) * ref->sin_lat;
+}
+
+/**
+ * \brief           Get distance between two points on WGS84 ellipsoid, Vincenty inverse formula
+ *
+ *                  Iterative and accurate to millimeters, use for single points only
+ * \param[in]       lat1, lon1: First point in degrees
+ * \param[in]       lat2, lon2: Second point in degrees
+ * \param[out]      bearing: Initial bearing from first to second point in degrees. Set to `NULL` if not used
+ * \return          Distance in meters
+ */
+gps_float_t
+gps_geo_vincenty(gps_float_t lat1, gps_float_t lon1, gps_float_t lat2, gps_float_t lon2, gps_float_t* bearing) {
+    gps_float_t u1, u2, su1, cu1, su2, cu2, l, lam, lam_prev;
+    gps_float_t sl, cl, ss, cs, sig, sa, c2a, c2sm, c, uu, ka, kb, ds;
+    int i;
+
+    u1 = FLT(atan((1 - WGS84_F) * tan(lat1 * DEG_TO_RAD)));     /* Reduced latitudes */
+    u2 = FLT(atan((1 - WGS84_F) * tan(lat2 * DEG_TO_RAD)));
+    su1 = FLT(sin(u1)); cu1 = FLT(cos(u1));
+    su2 = FLT(sin(u2)); cu2 = FLT(cos(u2));
+    l = (lon2 - lon1) * DEG_TO_RAD;
+    lam = l;
+
+    ss = cs = sig = c2a = c2sm = sl = cl = 0;
+    for (i = 0; i < VINCENTY_ITER; i++) {
+        sl = FLT(sin(lam)); cl = FLT(cos(lam));
+        ss = FLT(sqrt((cu2 * sl) * (cu2 * sl) + (cu1 * su2 - su1 * cu2 * cl) * (cu1 * su2 - su1 * cu2 * cl)));
+        if (ss == 0) {
+            if (bearing != NULL) {
+                *bearing = 0;
+            }
+            return 0;                           /* Coincident points */
+        }
+        cs = su1 * su2 + cu1 * cu2 * cl;
+        sig = FLT(atan2(ss, cs));
+        sa = cu1 * cu2 * sl / ss;
+        c2a = 1 - sa * sa;
+        c2sm = c2a != 0 ? cs - 2 * su1 * su2 / c2a : 0;     /* Equatorial line */
+        c = WGS84_F / 16 * c2a * (4 + WGS84_F * (4 - 3 * c2a));
+        lam_prev = lam;
+        lam = l + (1 - c) * WGS84_F * sa * (sig + c * ss * (c2sm + c * cs * (-1 + 2 * c2sm * c2sm)));
+        if (FLT(fabs(lam - lam_prev)) < VINCENTY_EPS) {
+            break;
+        }
+    }
+
+    uu = c2a * (WGS84_A * WGS84_A - WGS84_B * WGS84_B) / (WGS84_B * WGS84_B);
+    ka = 1 + uu / 16384 * (4096 + uu * (-768 + uu * (320 - 175 * uu)));
+    kb = uu / 1024 * (256 + uu * (-128 + uu * (74 - 47 * uu)));
+    ds = kb * ss * (c2sm + kb / 4 * (cs * (-1 + 2 * c2sm * c2sm)
+            - kb / 6 * c2sm * (-3 + 4 * ss * ss) * (-3 + 4 * c2sm * c2sm)));
+    if (bearing != NULL) {
+        *bearing = FLT(atan2(cu2 * sl, cu1 * su2 - su1 * cu2 * cl)) * RAD_TO_DEG;
+        *bearing += *bearing < 0 ? FLT(360) : FLT(0);
+    }
+    return WGS84_B * ka * (sig - ds);
+}
+
+/**
+ * \brief           Get great circle distances of points from reference point, haversine formula
+ * \param[in]       ref: Reference point
+ * \param[in]       lat: Latitudes in degrees
+ * \param[in]       lon: Longitudes in degrees
+ * \param[out]      dist: Distances in meters
+ * \param[in]       n: Number of points
+ */
+void
+gps_geo_range(const gps_geo_ref_t* ref, const gps_float_t* GPS_RESTRICT lat,
+                const gps_float_t* GPS_RESTRICT lon, gps_float_t* GPS_RESTRICT dist, size_t n) {
+    const gps_float_t lat0 = ref->latitude * DEG_TO_RAD, lon0 = ref->longitude * DEG_TO_RAD, c0 = ref->cos_lat;
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        gps_float_t p = lat[i] * DEG_TO_RAD;
+        gps_float_t sp = FLT(sin((p - lat0) * FLT(0.5)));
+        gps_float_t sl = FLT(sin((lon[i] * DEG_TO_RAD - lon0) * FLT(0.5)));
+        gps_float_t a = sp * sp + c0 * FLT(cos(p)) * sl * sl;
+        dist[i] = 2 * EARTH_RADIUS * FLT(asin(sqrt(a)));
+    }
+}
+
+/**
+ * \brief           Get initial bearings from reference point to points
+ * \param[in]       ref: Reference point
+ * \param[in]       lat: Latitudes in degrees
+ * \param[in]       lon: Longitudes in degrees
+ * \param[out]      brg: Bearings in degrees, `0` to `360` clockwise from north
+ * \param[in]       n: Number of points
+ */
+void
+gps_geo_bearing(const gps_geo_ref_t* ref, const gps_float_t* GPS_RESTRICT lat,
+                const gps_float_t* GPS_RESTRICT lon, gps_float_t* GPS_RESTRICT brg, size_t n) {
+    const gps_float_t lon0 = ref->longitude * DEG_TO_RAD, s0 = ref->sin_lat, c0 = ref->cos_lat;
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        gps_float_t dl = lon[i] * DEG_TO_RAD - lon0;
+        gps_float_t sp = FLT(sin(lat[i] * DEG_TO_RAD)), cp = FLT(sqrt(1 - sp * sp));
+        gps_float_t b = FLT(atan2(FLT(sin(dl)) * cp, c0 * sp - s0 * cp * FLT(sin(dl + HALF_PI)))) * RAD_TO_DEG;
+        brg[i] = b + (b < 0) * FLT(360);
+    }
+}
+
+/**
+ * \brief           Get distances between consecutive points of track, haversine formula
+ * \param[in]       lat: Latitudes in degrees
+ * \param[in]       lon: Longitudes in degrees
+ * \param[out]      dist: Distances in meters, `dist[i]` from point `i - 1` to `i`, `dist[0]` is `0`
+ * \param[in]       n: Number of points
+ */
+void
+gps_geo_track(const gps_float_t* GPS_RESTRICT lat, const gps_float_t* GPS_RESTRICT lon,
+                gps_float_t* GPS_RESTRICT dist, size_t n) {
+    size_t i;
+
+    if (n == 0) {
+        return;
+    }
+    dist[0] = 0;
+    for (i = 1; i < n; i++) {
+        gps_float_t p0 = lat[i - 1] * DEG_TO_RAD, p1 = lat[i] * DEG_TO_RAD;
+        gps_float_t sp = FLT(sin((p1 - p0) * FLT(0.5)));
+        gps_float_t sl = FLT(sin((lon[i] - lon[i - 1]) * DEG_TO_RAD * FLT(0.5)));
+        gps_float_t a = sp * sp + FLT(cos(p0)) * FLT(cos(p1)) * sl * sl;
+        dist[i] = 2 * EARTH_RADIUS * FLT(asin(sqrt(a)));
+    }
+}
+
+/**
+ * \brief           Get ellipsoidal distances of points from reference point, Vincenty formula
+ *
+ *                  Scalar loop, iterations differ per point
+ * \param[in]       ref: Reference point
+ * \param[in]       lat: Latitudes in degrees
+ * \param[in]       lon: Longitudes in degrees
+ * \param[out]      dist: Distances in meters
+ * \param[in]       n: Number of points
+ */
+void
+gps_geo_vincenty_range(const gps_geo_ref_t* ref, const gps_float_t* GPS_RESTRICT lat,
+                const gps_float_t* GPS_RESTRICT lon, gps_float_t* GPS_RESTRICT dist, size_t n) {
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        dist[i] = gps_geo_vincenty(ref->latitude, ref->longitude, lat[i], lon[i], NULL);
+    }
+}
+
+/**
+ * \brief           Convert geodetic coordinates to earth-centered earth-fixed (ECEF), WGS84
+ * \param[in]       lat: Latitudes in degrees
+ * \param[in]       lon: Longitudes in degrees
+ * \param[in]       alt: Altitudes above ellipsoid in meters
+ * \param[out]      x, y, z: ECEF coordinates in meters
+ * \param[in]       n: Number of points
+ */
+void
+gps_geo_to_ecef(const gps_float_t* GPS_RESTRICT lat, const gps_float_t* GPS_RESTRICT lon,
+                const gps_float_t* GPS_RESTRICT alt, gps_float_t* GPS_RESTRICT x,
+                gps_float_t* GPS_RESTRICT y, gps_float_t* GPS_RESTRICT z, size_t n) {
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        gps_float_t sp = FLT(sin(lat[i] * DEG_TO_RAD)), cp = FLT(sqrt(1 - sp * sp));
+        gps_float_t sl = FLT(sin(lon[i] * DEG_TO_RAD)), cl = FLT(sin(lon[i] * DEG_TO_RAD + HALF_PI));
+        gps_float_t nr = WGS84_A / FLT(sqrt(1 - WGS84_E2 * sp * sp));
+        x[i] = (nr + alt[i]) * cp * cl;
+        y[i] = (nr + alt[i]) * cp * sl;
+        z[i] = (nr * (1 - WGS84_E2) + alt[i]) * sp;
+    }
+}
+
+/**
+ * \brief           Convert ECEF coordinates to local east-north-up frame of reference point
+ * \param[in]       ref: Reference point
+ * \param[in]       x, y, z: ECEF coordinates in meters
+ * \param[out]      e, nn, u: East, north and up coordinates in meters
+ * \param[in]       n: Number of points
+ */
+void
+gps_geo_ecef_to_enu(const gps_geo_ref_t* ref, const gps_float_t* GPS_RESTRICT x,
+                const gps_float_t* GPS_RESTRICT y, const gps_float_t* GPS_RESTRICT z,
+                gps_float_t* GPS_RESTRICT e, gps_float_t* GPS_RESTRICT nn, gps_float_t* GPS_RESTRICT u, size_t n) {
+    const gps_float_t sp = ref->sin_lat, cp = ref->cos_lat, sl = ref->sin_lon, cl = ref->cos_lon;
+    const gps_float_t x0 = ref->x, y0 = ref->y, z0 = ref->z;
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        gps_float_t dx = x[i] - x0, dy = y[i] - y0, dz = z[i] - z0;
+        e[i] = -sl * dx + cl * dy;
+        nn[i] = -sp * cl * dx - sp * sl * dy + cp * dz;
+        u[i] = cp * cl * dx + cp * sl * dy + sp * dz;
+    }
+}
+
+/**
+ * \brief           Convert geodetic coordinates to local east-north-up frame of reference point
+ *
+ *                  Same as \ref gps_geo_to_ecef followed by \ref gps_geo_ecef_to_enu,
+ *                  without intermediate arrays
+ * \param[in]       ref: Reference point
+ * \param[in]       lat: Latitudes in degrees
+ * \param[in]       lon: Longitudes in degrees
+ * \param[in]       alt: Altitudes above ellipsoid in meters
+ * \param[out]      e, nn, u: East, north and up coordinates in meters
+ * \param[in]       n: Number of points
+ */
+void
+gps_geo_to_enu(const gps_geo_ref_t* ref, const gps_float_t* GPS_RESTRICT lat,
+                const gps_float_t* GPS_RESTRICT lon, const gps_float_t* GPS_RESTRICT alt,
+                gps_float_t* GPS_RESTRICT e, gps_float_t* GPS_RESTRICT nn, gps_float_t* GPS_RESTRICT u, size_t n) {
+    const gps_float_t sp0 = ref->sin_lat, cp0 = ref->cos_lat, sl0 = ref->sin_lon, cl0 = ref->cos_lon;
+    const gps_float_t x0 = ref->x, y0 = ref->y, z0 = ref->z;
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        gps_float_t sp = FLT(sin(lat[i] * DEG_TO_RAD)), cp = FLT(sqrt(1 - sp * sp));
+        gps_float_t sl = FLT(sin(lon[i] * DEG_TO_RAD)), cl = FLT(sin(lon[i] * DEG_TO_RAD + HALF_PI));
+        gps_float_t nr = WGS84_A / FLT(sqrt(1 - WGS84_E2 * sp * sp));
+        gps_float_t dx = (nr + alt[i]) * cp * cl - x0;
+        gps_float_t dy = (nr + alt[i]) * cp * sl - y0;
+        gps_float_t dz = (nr * (1 - WGS84_E2) + alt[i]) * sp - z0;
+        e[i] = -sl0 * dx + cl0 * dy;
+        nn[i] = -sp0 * cl0 * dx - sp0 * sl0 * dy + cp0 * dz;
+        u[i] = cp0 * cl0 * dx + cp0 * sl0 * dy + sp0 * dz;
+    }
+}
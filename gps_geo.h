@@ -0,0 +1,75 @@
+/*
+ * gps_geo.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ */
+
+#ifndef GPS_GEO_H_
+#define GPS_GEO_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "gps.h"
+
+/**
+ * \brief           Pointer qualifier telling compiler that arrays do not overlap
+ *
+ * \note            Batch functions take arrays (structure of arrays) and loop over them
+ *                  without branches, so they vectorize on host when built with
+ *                  `-O3 -ffast-math -march=x86-64-v3` (vector `sin`, `asin`, `atan2`
+ *                  from `libmvec`). Sine and cosine of one angle are not used together,
+ *                  as compiler would merge them to `sincos` which does not vectorize.
+ *                  On target they compile to plain scalar loops
+ */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L
+#define GPS_RESTRICT                        restrict
+#elif defined(__GNUC__)
+#define GPS_RESTRICT                        __restrict__
+#else
+#define GPS_RESTRICT
+#endif
+
+/**
+ * \brief           Reference point of local frame, for example launch pad
+ */
+typedef struct {
+    gps_float_t latitude;                       /*!< Latitude in degrees */
+    gps_float_t longitude;                      /*!< Longitude in degrees */
+    gps_float_t altitude;                       /*!< Altitude in meters */
+    gps_float_t sin_lat;                        /*!< Sine of latitude */
+    gps_float_t cos_lat;                        /*!< Cosine of latitude */
+    gps_float_t sin_lon;                        /*!< Sine of longitude */
+    gps_float_t cos_lon;                        /*!< Cosine of longitude */
+    gps_float_t x;                              /*!< ECEF X coordinate in meters */
+    gps_float_t y;                              /*!< ECEF Y coordinate in meters */
+    gps_float_t z;                              /*!< ECEF Z coordinate in meters */
+} gps_geo_ref_t;
+
+/* Reference point */
+void        gps_geo_ref_init(gps_geo_ref_t* ref, gps_float_t lat, gps_float_t lon, gps_float_t alt);
+
+/* Single point functions */
+gps_float_t gps_geo_vincenty(gps_float_t lat1, gps_float_t lon1, gps_float_t lat2, gps_float_t lon2, gps_float_t* bearing);
+
+/* Batch functions over arrays of `n` points */
+void        gps_geo_range(const gps_geo_ref_t* ref, const gps_float_t* GPS_RESTRICT lat,
+                const gps_float_t* GPS_RESTRICT lon, gps_float_t* GPS_RESTRICT dist, size_t n);
+void        gps_geo_bearing(const gps_geo_ref_t* ref, const gps_float_t* GPS_RESTRICT lat,
+                const gps_float_t* GPS_RESTRICT lon, gps_float_t* GPS_RESTRICT brg, size_t n);
+void        gps_geo_track(const gps_float_t* GPS_RESTRICT lat, const gps_float_t* GPS_RESTRICT lon,
+                gps_float_t* GPS_RESTRICT dist, size_t n);
+void        gps_geo_vincenty_range(const gps_geo_ref_t* ref, const gps_float_t* GPS_RESTRICT lat,
+                const gps_float_t* GPS_RESTRICT lon, gps_float_t* GPS_RESTRICT dist, size_t n);
+void        gps_geo_to_ecef(const gps_float_t* GPS_RESTRICT lat, const gps_float_t* GPS_RESTRICT lon,
+                const gps_float_t* GPS_RESTRICT alt, gps_float_t* GPS_RESTRICT x,
+                gps_float_t* GPS_RESTRICT y, gps_float_t* GPS_RESTRICT z, size_t n);
+void        gps_geo_ecef_to_enu(const gps_geo_ref_t* ref, const gps_float_t* GPS_RESTRICT x,
+                const gps_float_t* GPS_RESTRICT y, const gps_float_t* GPS_RESTRICT z,
+                gps_float_t* GPS_RESTRICT e, gps_float_t* GPS_RESTRICT nn, gps_float_t* GPS_RESTRICT u, size_t n);
+void        gps_geo_to_enu(const gps_geo_ref_t* ref, const gps_float_t* GPS_RESTRICT lat,
+                const gps_float_t* GPS_RESTRICT lon, const gps_float_t* GPS_RESTRICT alt,
+                gps_float_t* GPS_RESTRICT e, gps_float_t* GPS_RESTRICT nn, gps_float_t* GPS_RESTRICT u, size_t n);
+
+#endif /* GPS_GEO_H_ */
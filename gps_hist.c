@@ -0,0 +1,209 @@
+/*
+ * gps_hist.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ */
+
+#include "gps_hist.h"
+
+#include <math.h>
+#include <string.h>
+
+#define EARTH_RADIUS        FLT(6371000.0)
+#define DEG_TO_RAD          FLT(0.017453292519943295)
+#define FLT(x)              ((gps_float_t)(x))
+#define IDX(_h, age)        (((_h)->head + GPS_CFG_HIST_SIZE - (age)) % GPS_CFG_HIST_SIZE)
+
+GPS_STATIC_ASSERT(GPS_CFG_HIST_SIZE >= 2, hist_size);
+GPS_STATIC_ASSERT(GPS_CFG_HIST_AVG > 0 && GPS_CFG_HIST_AVG <= GPS_CFG_HIST_SIZE, hist_avg);
+
+/**
+ * \brief           Get number of fixes in averaging window
+ */
+static size_t
+avg_count(const gps_hist_t* h) {
+    return h->count < GPS_CFG_HIST_AVG ? h->count : GPS_CFG_HIST_AVG;
+}
+
+/**
+ * \brief           Init history
+ * \param[in]       h: History handle
+ */
+void
+gps_hist_init(gps_hist_t* h) {
+    memset(h, 0x00, sizeof(*h));
+}
+
+/**
+ * \brief           Add published fix to history and update running statistics
+ *
+ *                  Fixes without valid position or time and repeated epochs are ignored.
+ *                  First fix after date becomes known has no velocity, epochs before count from day `0`
+ * \param[in]       h: History handle
+ * \param[in]       gga: Published GGA values
+ * \return          `1` when fix was added, `0` otherwise
+ */
+uint8_t
+gps_hist_push(gps_hist_t* h, const gps_gga_t* gga) {
+    gps_hist_entry_t* e;
+    const gps_hist_entry_t* prev = NULL;
+    gps_float_t t, dt;
+    size_t i;
+
+    if (!gga->fix || !gga->timed) {
+        return 0;
+    }
+    t = FLT(gga->epoch) * FLT(1e-6);
+    if (h->count) {
+        prev = &h->e[h->head];
+        if (prev->gga.dated != gga->dated) {
+            prev = NULL;                        /* Time base changed, no difference to previous fix */
+        } else if (t <= prev->t) {
+            return 0;                           /* Same epoch again */
+        }
+    }
+
+    if (h->count >= GPS_CFG_HIST_AVG) {         /* Oldest fix leaves averaging window */
+        i = IDX(h, GPS_CFG_HIST_AVG - 1);
+        h->alt_sum -= h->e[i].gga.altitude;
+        h->vu_sum -= h->e[i].vu;
+    }
+    h->head = h->count ? (h->head + 1) % GPS_CFG_HIST_SIZE : 0;
+    h->count += h->count < GPS_CFG_HIST_SIZE;
+
+    e = &h->e[h->head];
+    e->gga = *gga;
+    e->t = t;
+    e->vn = e->ve = e->vu = 0;
+    dt = prev != NULL ? t - prev->t : FLT(0);
+    if (prev != NULL && dt <= FLT(GPS_CFG_HIST_MAX_GAP)) {  /* Finite difference to recent previous fix */
+        e->vn = (gps_aux_float_t)((gga->latitude - prev->gga.latitude) * DEG_TO_RAD * EARTH_RADIUS / dt);
+        e->ve = (gps_aux_float_t)((gga->longitude - prev->gga.longitude) * DEG_TO_RAD * EARTH_RADIUS
+                    * FLT(cos(gga->latitude * DEG_TO_RAD)) / dt);
+        e->vu = (gps_aux_float_t)((gga->altitude - prev->gga.altitude) / dt);
+    }
+    h->alt_sum += e->gga.altitude;
+    h->vu_sum += e->vu;
+
+    if (h->count == 1 || e->gga.altitude > h->alt_max) {
+        h->alt_max = e->gga.altitude;
+        h->alt_max_t = t;
+    }
+    if (!h->apogee && h->count >= GPS_CFG_HIST_AVG && h->vu_sum < 0
+        && h->alt_max - gps_hist_alt_avg(h) >= FLT(GPS_CFG_HIST_APOGEE_DROP)) {
+        h->apogee = 1;                          /* Descending well below maximum */
+    }
+    return 1;
+}
+
+/**
+ * \brief           Get number of fixes in history
+ * \param[in]       h: History handle
+ * \return          Number of fixes
+ */
+size_t
+gps_hist_count(const gps_hist_t* h) {
+    return h->count;
+}
+
+/**
+ * \brief           Get fix from history
+ * \param[in]       h: History handle
+ * \param[in]       age: Age of fix, `0` for latest
+ * \return          Pointer to fix, `NULL` when history is shorter
+ */
+const gps_hist_entry_t*
+gps_hist_get(const gps_hist_t* h, size_t age) {
+    if (age >= h->count) {
+        return NULL;
+    }
+    return &h->e[IDX(h, age)];
+}
+
+/**
+ * \brief           Get velocity between two latest fixes
+ * \param[in]       h: History handle
+ * \param[out]      vn: Velocity towards north in units of m/s. Set to `NULL` if not used
+ * \param[out]      ve: Velocity towards east in units of m/s. Set to `NULL` if not used
+ * \param[out]      vu: Climb rate in units of m/s. Set to `NULL` if not used
+ * \return          `1` on success, `0` when history has less than `2` fixes
+ */
+uint8_t
+gps_hist_velocity(const gps_hist_t* h, gps_float_t* vn, gps_float_t* ve, gps_float_t* vu) {
+    const gps_hist_entry_t* e = &h->e[h->head];
+
+    if (h->count < 2) {
+        return 0;
+    }
+    if (vn != NULL) {
+        *vn = e->vn;
+    }
+    if (ve != NULL) {
+        *ve = e->ve;
+    }
+    if (vu != NULL) {
+        *vu = e->vu;
+    }
+    return 1;
+}
+
+/**
+ * \brief           Get climb rate averaged over last \ref GPS_CFG_HIST_AVG fixes
+ * \param[in]       h: History handle
+ * \return          Climb rate in units of m/s
+ */
+gps_float_t
+gps_hist_climb_avg(const gps_hist_t* h) {
+    size_t n = avg_count(h);
+    return n ? h->vu_sum / FLT(n) : FLT(0);
+}
+
+/**
+ * \brief           Get altitude averaged over last \ref GPS_CFG_HIST_AVG fixes
+ * \param[in]       h: History handle
+ * \return          Altitude in units of meters
+ */
+gps_float_t
+gps_hist_alt_avg(const gps_hist_t* h) {
+    size_t n = avg_count(h);
+    return n ? h->alt_sum / FLT(n) : FLT(0);
+}
+
+/**
+ * \brief           Get maximum altitude since init
+ * \param[in]       h: History handle
+ * \param[out]      t: Time of maximum in units of seconds. Set to `NULL` if not used
+ * \return          Altitude in units of meters
+ */
+gps_float_t
+gps_hist_alt_max(const gps_hist_t* h, gps_float_t* t) {
+    if (t != NULL) {
+        *t = h->alt_max_t;
+    }
+    return h->alt_max;
+}
+
+/**
+ * \brief           Check if apogee was passed
+ *
+ *                  Apogee is detected when average climb rate is negative and average
+ *                  altitude dropped \ref GPS_CFG_HIST_APOGEE_DROP below maximum
+ * \param[in]       h: History handle
+ * \param[out]      alt: Apogee altitude in units of meters. Set to `NULL` if not used
+ * \param[out]      t: Apogee time in units of seconds. Set to `NULL` if not used
+ * \return          `1` when apogee was detected, `0` otherwise
+ */
+uint8_t
+gps_hist_apogee(const gps_hist_t* h, gps_float_t* alt, gps_float_t* t) {
+    if (!h->apogee) {
+        return 0;
+    }
+    if (alt != NULL) {
+        *alt = h->alt_max;
+    }
+    if (t != NULL) {
+        *t = h->alt_max_t;
+    }
+    return 1;
+}
@@ -0,0 +1,85 @@
+/*
+ * gps_hist.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ */
+
+#ifndef GPS_HIST_H_
+#define GPS_HIST_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "gps.h"
+
+/**
+ * \brief           Number of fixes kept in history
+ */
+#ifndef GPS_CFG_HIST_SIZE
+#define GPS_CFG_HIST_SIZE                   16
+#endif
+
+/**
+ * \brief           Number of latest fixes in moving averages, up to \ref GPS_CFG_HIST_SIZE
+ */
+#ifndef GPS_CFG_HIST_AVG
+#define GPS_CFG_HIST_AVG                    4
+#endif
+
+/**
+ * \brief           Longest time between fixes in units of seconds, over which velocity is derived.
+ *                  Longer gaps give zero velocity
+ */
+#ifndef GPS_CFG_HIST_MAX_GAP
+#define GPS_CFG_HIST_MAX_GAP                5.0
+#endif
+
+/**
+ * \brief           Drop of average altitude below maximum in units of meters,
+ *                  at which apogee is detected
+ */
+#ifndef GPS_CFG_HIST_APOGEE_DROP
+#define GPS_CFG_HIST_APOGEE_DROP            10.0
+#endif
+
+/**
+ * \brief           Fix in history, with velocity derived from previous fix
+ */
+typedef struct {
+    gps_gga_t gga;                              /*!< Published GGA values */
+    gps_float_t t;                              /*!< UTC time in units of seconds since 1970-01-01, from epoch of fix */
+    gps_aux_float_t vn;                         /*!< Velocity towards north in units of m/s */
+    gps_aux_float_t ve;                         /*!< Velocity towards east in units of m/s */
+    gps_aux_float_t vu;                         /*!< Climb rate in units of m/s */
+} gps_hist_entry_t;
+
+/**
+ * \brief           History of last published fixes with running statistics
+ */
+typedef struct {
+    gps_hist_entry_t e[GPS_CFG_HIST_SIZE];      /*!< Ring of fixes */
+    size_t head;                                /*!< Index of latest fix */
+    size_t count;                               /*!< Number of fixes in ring */
+
+    gps_float_t alt_sum;                        /*!< Sum of altitudes in averaging window */
+    gps_float_t vu_sum;                         /*!< Sum of climb rates in averaging window */
+    gps_float_t alt_max;                        /*!< Maximum altitude since init */
+    gps_float_t alt_max_t;                      /*!< Time of maximum altitude */
+    uint8_t apogee;                             /*!< Set to `1` once apogee was detected */
+} gps_hist_t;
+
+/* GPS history prototypes */
+void        gps_hist_init(gps_hist_t* h);
+uint8_t     gps_hist_push(gps_hist_t* h, const gps_gga_t* gga);
+size_t      gps_hist_count(const gps_hist_t* h);
+const gps_hist_entry_t* gps_hist_get(const gps_hist_t* h, size_t age);
+
+/* Queries, constant time */
+uint8_t     gps_hist_velocity(const gps_hist_t* h, gps_float_t* vn, gps_float_t* ve, gps_float_t* vu);
+gps_float_t gps_hist_climb_avg(const gps_hist_t* h);
+gps_float_t gps_hist_alt_avg(const gps_hist_t* h);
+gps_float_t gps_hist_alt_max(const gps_hist_t* h, gps_float_t* t);
+uint8_t     gps_hist_apogee(const gps_hist_t* h, gps_float_t* alt, gps_float_t* t);
+
+#endif /* GPS_HIST_H_ */
@@ -0,0 +1,262 @@
+/*
+ * gps_prof.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ */
+
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE     199309L             /* clock_gettime */
+#endif
+
+#include "gps_prof.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__linux__) || defined(__APPLE__)
+#define PROF_CLOCK_POSIX            1
+#include <time.h>
+#if GPS_CFG_PROF_RDTSC && (defined(__x86_64__) || defined(__i386__))
+#define PROF_CLOCK_RDTSC            1
+#include <x86intrin.h>
+#endif
+#elif defined(__TI_ARM__) || defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+#define PROF_CLOCK_DWT              1
+#define DWT_CTRL                    (*(volatile uint32_t *)0xE0001000)  /* DWT control register */
+#define DWT_CYCCNT                  (*(volatile uint32_t *)0xE0001004)  /* DWT cycle counter */
+#define DEMCR                       (*(volatile uint32_t *)0xE000EDFC)  /* Debug exception and monitor control */
+#define DEMCR_TRCENA                (1UL << 24)
+#define DWT_CTRL_CYCCNTENA          (1UL << 0)
+#endif
+
+#if PROF_CLOCK_RDTSC
+#define PROF_TPS_DEFAULT            0           /* Unknown until calibrated */
+#elif PROF_CLOCK_POSIX
+#define PROF_TPS_DEFAULT            1000000000UL
+#elif PROF_CLOCK_DWT
+#define PROF_TPS_DEFAULT            GPS_CFG_PROF_CPU_HZ
+#else
+#define PROF_TPS_DEFAULT            0
+#endif
+
+static gps_tick_t clock_default(void);
+
+static gps_prof_clock_fn prof_clock = clock_default;    /*!< Active clock function */
+static uint32_t prof_tps = PROF_TPS_DEFAULT;            /*!< Ticks per second of active clock */
+#if PROF_CLOCK_RDTSC
+static uint8_t prof_shift;                              /*!< Right shift of `rdtsc`, keeps tick rate within 32 bits */
+#endif /* PROF_CLOCK_RDTSC */
+
+#if GPS_CFG_PROF
+static gps_prof_stat_t prof_stat[GPS_PROF_ZONES];       /*!< Statistics for each zone */
+
+static const char* const prof_name[GPS_PROF_USER] = {
+    "gps_process",
+    "parse_term",
+    "buff_write",
+    "uart_isr",
+};
+#endif /* GPS_CFG_PROF */
+
+/**
+ * \brief           Default clock of the platform
+ * \return          Current time in units of ticks
+ */
+static gps_tick_t
+clock_default(void) {
+#if PROF_CLOCK_RDTSC
+    return (gps_tick_t)(__rdtsc() >> prof_shift);
+#elif PROF_CLOCK_POSIX
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (gps_tick_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+#elif PROF_CLOCK_DWT
+    return (gps_tick_t)DWT_CYCCNT;
+#else
+    return 0;                                   /* No clock, set one with gps_prof_set_clock */
+#endif
+}
+
+/**
+ * \brief           Initialize default clock of the platform
+ *
+ *                  On target, it enables DWT cycle counter, on host with `rdtsc` it calibrates tick rate
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gps_prof_init(void) {
+#if PROF_CLOCK_RDTSC
+    struct timespec t0, t1;
+    uint64_t c0, c1, ns, tps;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    c0 = __rdtsc();
+    do {                                        /* Calibrate against monotonic clock for 20ms */
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        ns = (uint64_t)(t1.tv_sec - t0.tv_sec) * 1000000000ULL + (uint64_t)t1.tv_nsec - (uint64_t)t0.tv_nsec;
+    } while (ns < 20000000ULL);
+    c1 = __rdtsc();
+    tps = (c1 - c0) * 1000000000ULL / ns;
+    for (prof_shift = 0; tps > 0xFFFFFFFFULL; prof_shift++) {
+        tps >>= 1;                              /* Counters of 4.29 GHz and faster are divided down */
+    }
+    prof_tps = (uint32_t)tps;
+#elif PROF_CLOCK_POSIX
+    prof_tps = 1000000000UL;
+#elif PROF_CLOCK_DWT
+    DEMCR |= DEMCR_TRCENA;                      /* Enable trace and debug blocks */
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;             /* Start cycle counter */
+    prof_tps = GPS_CFG_PROF_CPU_HZ;
+#else
+    return 0;
+#endif
+    prof_clock = clock_default;
+    return 1;
+}
+
+/**
+ * \brief           Set clock used for profiling and timestamps
+ * \param[in]       fn: Clock function. Set to `NULL` to use platform default
+ * \param[in]       ticks_per_sec: Tick rate of clock in units of Hz
+ */
+void
+gps_prof_set_clock(gps_prof_clock_fn fn, uint32_t ticks_per_sec) {
+    prof_clock = fn != NULL ? fn : clock_default;
+    prof_tps = ticks_per_sec;
+}
+
+/**
+ * \brief           Get current time
+ * \return          Current time in units of ticks
+ */
+gps_tick_t
+gps_prof_now(void) {
+    return prof_clock();
+}
+
+/**
+ * \brief           Get tick rate of active clock
+ * \return          Ticks per second, `0` when clock is not initialized
+ */
+uint32_t
+gps_prof_ticks_per_sec(void) {
+    return prof_tps;
+}
+
+/**
+ * \brief           Add sample to zone statistics
+ * \note            Each zone must be updated from one context only (either thread or interrupt)
+ * \param[in]       zone: Zone to update
+ * \param[in]       ticks: Duration of sample in units of ticks
+ */
+void
+gps_prof_add(gps_prof_zone_t zone, gps_tick_t ticks) {
+#if GPS_CFG_PROF
+    gps_prof_stat_t* st;
+    uint8_t bin;
+
+    if ((unsigned)zone >= GPS_PROF_ZONES) {
+        return;
+    }
+    st = &prof_stat[zone];
+    if (st->count == 0 || ticks < st->min) {
+        st->min = ticks;
+    }
+    if (ticks > st->max) {
+        st->max = ticks;
+    }
+    st->count++;
+    st->sum += ticks;
+    for (bin = 0; (ticks >>= 1) != 0 && bin < (GPS_CFG_PROF_HIST_BINS - 1); bin++) {}
+    st->hist[bin]++;
+#else
+    (void)zone;
+    (void)ticks;
+#endif /* GPS_CFG_PROF */
+}
+
+/**
+ * \brief           Get copy of zone statistics
+ * \param[in]       zone: Zone to read
+ * \param[out]      stat: Output statistics
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gps_prof_get(gps_prof_zone_t zone, gps_prof_stat_t* stat) {
+#if GPS_CFG_PROF
+    if ((unsigned)zone >= GPS_PROF_ZONES || stat == NULL) {
+        return 0;
+    }
+    *stat = prof_stat[zone];
+    return 1;
+#else
+    (void)zone;
+    (void)stat;
+    return 0;
+#endif /* GPS_CFG_PROF */
+}
+
+/**
+ * \brief           Reset statistics of all zones
+ */
+void
+gps_prof_reset(void) {
+#if GPS_CFG_PROF
+    memset(prof_stat, 0x00, sizeof(prof_stat));
+#endif /* GPS_CFG_PROF */
+}
+
+/**
+ * \brief           Write report of all zones with at least one sample
+ *
+ *                  Durations are printed in units of nanoseconds when tick rate is known,
+ *                  followed by non-empty histogram bins as `<upper bound in ticks>:<count>`
+ * \param[in]       out: Output function, called once per line
+ * \param[in]       arg: User argument passed to output function
+ */
+void
+gps_prof_report(gps_prof_out_fn out, void* arg) {
+#if GPS_CFG_PROF
+    char line[256];
+    char name[16];
+    size_t len;
+    uint8_t z, b;
+    double ns;
+
+    if (out == NULL) {
+        return;
+    }
+    ns = prof_tps > 0 ? 1e9 / (double)prof_tps : 1.0;
+    out(prof_tps > 0 ? "zone             count      min ns      avg ns      max ns" :
+                       "zone             count   min ticks   avg ticks   max ticks", arg);
+    for (z = 0; z < GPS_PROF_ZONES; z++) {
+        const gps_prof_stat_t* st = &prof_stat[z];
+
+        if (st->count == 0) {
+            continue;
+        }
+        if (z < GPS_PROF_USER) {
+            snprintf(name, sizeof(name), "%s", prof_name[z]);
+        } else {
+            snprintf(name, sizeof(name), "user%u", (unsigned)(z - GPS_PROF_USER));
+        }
+        snprintf(line, sizeof(line), "%-12s %9lu %11.0f %11.0f %11.0f", name, (unsigned long)st->count,
+            (double)st->min * ns, (double)st->sum / (double)st->count * ns, (double)st->max * ns);
+        out(line, arg);
+
+        len = (size_t)snprintf(line, sizeof(line), "  hist");
+        for (b = 0; b < GPS_CFG_PROF_HIST_BINS && len < sizeof(line); b++) {
+            if (st->hist[b] > 0) {
+                len += (size_t)snprintf(&line[len], sizeof(line) - len, " <%lu:%lu",
+                    2UL << b, (unsigned long)st->hist[b]);
+            }
+        }
+        out(line, arg);
+    }
+#else
+    (void)out;
+    (void)arg;
+#endif /* GPS_CFG_PROF */
+}
@@ -0,0 +1,130 @@
+/*
+ * gps_prof.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ */
+
+#ifndef GPS_PROF_H_
+#define GPS_PROF_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "gps.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \brief           Enables `1` or disables `0` hot path profiling.
+ *
+ * \note            When disabled, \ref GPS_PROF_BEGIN and \ref GPS_PROF_END compile to nothing
+ *                  and no memory is used for zone statistics. Clock functions are always available.
+ */
+#ifndef GPS_CFG_PROF
+#define GPS_CFG_PROF                        0
+#endif
+
+/**
+ * \brief           Number of histogram bins per zone.
+ *                  Bin `n` counts samples with duration in range `[2^n, 2^(n+1))` ticks
+ */
+#ifndef GPS_CFG_PROF_HIST_BINS
+#define GPS_CFG_PROF_HIST_BINS              24
+#endif
+
+/**
+ * \brief           Number of zones available to application, on top of library zones
+ */
+#ifndef GPS_CFG_PROF_USER_ZONES
+#define GPS_CFG_PROF_USER_ZONES             4
+#endif
+
+/**
+ * \brief           CPU clock in Hz, used as tick rate of cycle counter on target
+ */
+#ifndef GPS_CFG_PROF_CPU_HZ
+#define GPS_CFG_PROF_CPU_HZ                 80000000UL
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` use of `rdtsc` as default clock on x86 hosts.
+ *                  When disabled, `clock_gettime` with monotonic clock is used
+ */
+#ifndef GPS_CFG_PROF_RDTSC
+#define GPS_CFG_PROF_RDTSC                  0
+#endif
+
+/**
+ * \brief           Profiling zones
+ */
+typedef enum {
+    GPS_PROF_PROCESS,                           /*!< \ref gps_process function */
+    GPS_PROF_PARSE_TERM,                        /*!< Single term parsing */
+    GPS_PROF_BUFF_WRITE,                        /*!< \ref buff_write function */
+    GPS_PROF_UART_ISR,                          /*!< UART receive interrupt */
+    GPS_PROF_USER,                              /*!< First zone available to application */
+    GPS_PROF_ZONES = GPS_PROF_USER + GPS_CFG_PROF_USER_ZONES    /*!< Number of zones */
+} gps_prof_zone_t;
+
+/**
+ * \brief           Statistics of single zone
+ */
+typedef struct {
+    uint32_t count;                             /*!< Number of samples */
+    gps_tick_t min;                             /*!< Shortest sample in units of ticks */
+    gps_tick_t max;                             /*!< Longest sample in units of ticks */
+    uint64_t sum;                               /*!< Sum of all samples in units of ticks */
+    uint32_t hist[GPS_CFG_PROF_HIST_BINS];      /*!< Log2 histogram of samples */
+} gps_prof_stat_t;
+
+/**
+ * \brief           Clock function, returns current time in units of ticks
+ */
+typedef gps_tick_t (*gps_prof_clock_fn)(void);
+
+/**
+ * \brief           Report output function, called once per line of text
+ * \param[in]       line: Null terminated line, without new line character
+ * \param[in]       arg: User argument
+ */
+typedef void (*gps_prof_out_fn)(const char* line, void* arg);
+
+#if GPS_CFG_PROF || __DOXYGEN__
+
+/**
+ * \brief           Start measurement of zone. Must be followed by \ref GPS_PROF_END in same scope
+ * \param[in]       zone: Zone, member of \ref gps_prof_zone_t
+ */
+#define GPS_PROF_BEGIN(zone)                gps_tick_t gps_prof_t0_ ## zone = gps_prof_now()
+
+/**
+ * \brief           End measurement of zone and add sample to its statistics
+ * \param[in]       zone: Zone, member of \ref gps_prof_zone_t
+ */
+#define GPS_PROF_END(zone)                  gps_prof_add((zone), (gps_tick_t)(gps_prof_now() - gps_prof_t0_ ## zone))
+
+#else
+#define GPS_PROF_BEGIN(zone)
+#define GPS_PROF_END(zone)
+#endif /* GPS_CFG_PROF || __DOXYGEN__ */
+
+/* Clock functions */
+uint8_t     gps_prof_init(void);
+void        gps_prof_set_clock(gps_prof_clock_fn fn, uint32_t ticks_per_sec);
+gps_tick_t  gps_prof_now(void);
+uint32_t    gps_prof_ticks_per_sec(void);
+
+/* Statistics */
+void        gps_prof_add(gps_prof_zone_t zone, gps_tick_t ticks);
+uint8_t     gps_prof_get(gps_prof_zone_t zone, gps_prof_stat_t* stat);
+void        gps_prof_reset(void);
+void        gps_prof_report(gps_prof_out_fn out, void* arg);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* GPS_PROF_H_ */
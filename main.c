@@ -20,22 +20,48 @@
 #include "driverlib/uart.h"
 #include "gps.h"
 #include "gps_buff.h"
+#include "gps_prof.h"
+#include "gps_fusion.h"
+#include "gps_hist.h"
+#include "gps_extrap.h"
 #include "driverlib/interrupt.h"
 
 /*
+Receiver 0:
 PD6 -->U2Rx
 PD7 -->U2Tx
+
+Receiver 1:
+PB0 -->U1Rx
+PB1 -->U1Tx
 */
 
 
 #define Buff_Data_size      138
+#define Buff_Marks_size     16
+#define GPS_Receivers       2
+#define UART_Int_Priority   0x20    /* Same for both receivers, buffer notification must not preempt itself */
+
+/* GPS handles, one per receiver  */
+gps_t hgps[GPS_Receivers];
+
+/* Fused fix of all receivers, updated once per epoch */
+gps_fusion_out_t hfix;
+static gps_fusion_t hfusion;
+
+/* History of fused fixes, for climb rate and apogee detection */
+gps_hist_t hhist;
 
-/* GPS handle  */
-gps_t hgps;
+/* Position extrapolated between fixes, query with gps_extrap_get(&hpos, gps_prof_now(), ...) */
+gps_extrap_t hpos;
 
-/* GPS buffer */
-static gps_buff_t hgps_buff;
-static uint8_t hgps_buff_data[Buff_Data_size];
+/* GPS buffers */
+static gps_buff_t hgps_buff[GPS_Receivers];
+static uint8_t hgps_buff_data[GPS_Receivers][Buff_Data_size];
+static gps_buff_mark_t hgps_buff_marks[GPS_Receivers][Buff_Marks_size];    /* Receive times of sentence delimiters */
+static gps_buff_sleep_waiter_t hgps_buff_waiter;            /* Sleeps main loop until any UART interrupt */
+
+static const uint32_t uart_base[GPS_Receivers] = { UART2_BASE, UART1_BASE };
 
 /*
  * 8-bit signed Integer = ASCII Characters
@@ -44,8 +70,70 @@ static uint8_t hgps_buff_data[Buff_Data_size];
 
 
 void UART_Init();
+void UART1IntHandler(void);
 void UART2IntHandler(void);
 
+/**
+ * \brief           Publish fused epochs, when all receivers reported them
+ */
+static void
+fuse(void) {
+    while (gps_fusion_update(&hfusion, &hfix)) {
+        gps_hist_push(&hhist, &hfix.fix.gga);
+#if GPS_CFG_RX_TIMESTAMP
+        gps_extrap_update(&hpos, &hfix.fix, hfix.fix.gga.rx_last);
+#else
+        gps_extrap_update(&hpos, &hfix.fix, gps_prof_now());
+#endif /* GPS_CFG_RX_TIMESTAMP */
+    }
+}
+
+/**
+ * \brief           Process one complete sentence of receiver like \ref gps_process_buff,
+ *                  fusing after every end of sentence (`\r`), so no epoch is overwritten unseen
+ * \param[in]       idx: Receiver index
+ * \return          Number of bytes processed, `0` when no complete sentence is in buffer
+ */
+static size_t
+process_sentence(uint8_t idx) {
+    uint8_t block[32];
+    const uint8_t *p, *eol;
+    size_t len, n, k, total;
+#if GPS_CFG_RX_TIMESTAMP
+    size_t off;
+    gps_tick_t ts;
+#endif /* GPS_CFG_RX_TIMESTAMP */
+
+    total = len = buff_wait_eol(&hgps_buff[idx], 0);    /* Up to and including new line */
+    while (len > 0) {
+        n = len < sizeof(block) ? len : sizeof(block);
+#if GPS_CFG_RX_TIMESTAMP
+        if (buff_mark_peek(&hgps_buff[idx], &off, &ts)) {
+            if (off == 0) {                         /* Marked byte is next */
+                gps_set_rx_time(&hgps[idx], ts);
+                off = 1;
+            }
+            n = off < n ? off : n;
+        }
+#endif /* GPS_CFG_RX_TIMESTAMP */
+        n = buff_read(&hgps_buff[idx], block, n);
+        if (n == 0) {
+            break;
+        }
+        len -= n;
+        p = block;
+        while ((eol = memchr(p, '\r', n)) != NULL) {
+            k = (size_t)(eol - p) + 1;
+            gps_process(&hgps[idx], p, k);          /* Fix is published at end of sentence */
+            fuse();
+            p += k;
+            n -= k;
+        }
+        gps_process(&hgps[idx], p, n);
+    }
+    return total;
+}
+
 
 
 void main(void)
@@ -54,77 +142,117 @@ void main(void)
         // Run the microcontroller system clock at 80MHz.
          SysCtlClockSet(SYSCTL_SYSDIV_2_5 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
 
-        UART_Init();
-        char residual = UARTCharGetNonBlocking(UART2_BASE);
-        IntMasterEnable();
+        gps_prof_init();                            /* Start cycle counter for profiling */
 
-        uint8_t rx;
+        gps_t* rx[GPS_Receivers];
+        uint8_t i;
 
-        gps_init(&hgps);                            /* Init GPS */
+        buff_sleep_waiter_init(&hgps_buff_waiter, SysCtlSleep);
+        for (i = 0; i < GPS_Receivers; i++) {
+            gps_init(&hgps[i]);                     /* Init GPS */
+            rx[i] = &hgps[i];
 
-        /* Create buffer for received data */
-        buff_init(&hgps_buff, hgps_buff_data, sizeof(hgps_buff_data));
+            /* Create buffer for received data, all buffers wake up the same main loop */
+            buff_init(&hgps_buff[i], hgps_buff_data[i], Buff_Data_size);
+            buff_init_marks(&hgps_buff[i], hgps_buff_marks[i], Buff_Marks_size);
+            buff_set_waiter(&hgps_buff[i], &hgps_buff_waiter.ops);
+        }
+        gps_fusion_init(&hfusion, rx, GPS_Receivers);
+        gps_hist_init(&hhist);
+        gps_extrap_init(&hpos);
+
+        UART_Init();
+        for (i = 0; i < GPS_Receivers; i++) {
+            char residual = UARTCharGetNonBlocking(uart_base[i]);
+            (void)residual;
+        }
+        IntMasterEnable();
 
         while (1) {
+            uint32_t seq = hgps_buff_waiter.ops.prepare(&hgps_buff_waiter.ops);
+            size_t n = 0;
+
+            /* One sentence of each receiver per round, so their epochs reach fusion in order */
+            for (i = 0; i < GPS_Receivers; i++) {
+                n += process_sentence(i);
+            }
 
-            /* Add new character to buffer */
-            /* Process all input data */
-            /* Read from buffer byte-by-byte and call processing function */
-            if (buff_get_full(&hgps_buff)) {    /* Check if anything in buffer now */
-                while (buff_read(&hgps_buff, &rx, 1)) {
-                    gps_process(&hgps, &rx, 1);     /* Process byte-by-byte */
-                }
+            if (n == 0) {                                   /* Sleep until any UART interrupt */
+                hgps_buff_waiter.ops.wait(&hgps_buff_waiter.ops, seq, GPS_BUFF_WAIT_FOREVER);
             }
         }
 
 
 }
+/**
+ * \brief           Configure UART for 9600 8-N-1 with receive interrupts
+ * \param[in]       base: UART base address
+ * \param[in]       interrupt: UART interrupt number
+ */
+static void UART_Config(uint32_t base, uint32_t interrupt)
+{
+     UARTDisable(base);
+
+    // Configure the UART for 9600 8-N-1.
+     UARTConfigSetExpClk(base, SysCtlClockGet(), 9600, (UART_CONFIG_WLEN_8 | UART_CONFIG_PAR_NONE | UART_CONFIG_STOP_ONE));
+     UARTFIFOLevelSet(base,UART_FIFO_TX4_8,UART_FIFO_RX4_8);
+     UARTEnable(base);
+
+
+     // Enable the NVIC interrupt, clear the UART individual interrupts and then enable.
+     IntPrioritySet(interrupt, UART_Int_Priority);
+     IntEnable(interrupt);
+     UARTIntClear(base, UARTIntStatus(base, false));
+     UARTIntEnable(base, (UART_INT_RX | UART_INT_RT));
+}
+
 void UART_Init(void)
 {
-    // Enable clock access to the GPIO Peripheral used by the UART2
+    // Enable clock access to the GPIO Peripherals used by the UART2 and UART1
     SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOD);
     while (!SysCtlPeripheralReady(SYSCTL_PERIPH_GPIOD));
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOB);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_GPIOB));
 
-    // Enable clock access to UART2
+    // Enable clock access to UART2 and UART1
     SysCtlPeripheralEnable(SYSCTL_PERIPH_UART2);
     while (!SysCtlPeripheralReady(SYSCTL_PERIPH_UART2));
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UART1);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_UART1));
 
 
     // Configure GPIO Pins for UART mode.
     GPIOPinConfigure(GPIO_PD6_U2RX);
     GPIOPinConfigure(GPIO_PD7_U2TX);
     GPIOPinTypeUART(GPIO_PORTD_BASE, GPIO_PIN_6 | GPIO_PIN_7);
+    GPIOPinConfigure(GPIO_PB0_U1RX);
+    GPIOPinConfigure(GPIO_PB1_U1TX);
+    GPIOPinTypeUART(GPIO_PORTB_BASE, GPIO_PIN_0 | GPIO_PIN_1);
 
-     UARTDisable(UART2_BASE);
-
-    // Configure the UART for 9600 8-N-1.
-     UARTConfigSetExpClk(UART2_BASE, SysCtlClockGet(), 9600, (UART_CONFIG_WLEN_8 | UART_CONFIG_PAR_NONE | UART_CONFIG_STOP_ONE));
-     UARTFIFOLevelSet(UART2_BASE,UART_FIFO_TX4_8,UART_FIFO_RX4_8);
-     UARTEnable(UART2_BASE);
-
-
-     // Enable the NVIC interrupt, clear the UART individual interrupts and then enable.
-     IntEnable(INT_UART2);
-     UARTIntClear(UART2_BASE, UARTIntStatus(UART2_BASE, false));
-     UARTIntEnable(UART2_BASE, (UART_INT_RX | UART_INT_RT));
+    UART_Config(UART2_BASE, INT_UART2);
+    UART_Config(UART1_BASE, INT_UART1);
 }
 
 /**
  * \brief           Interrupt handler routing for UART received character
+ * \param[in]       idx: Receiver index
  * \note
  */
-void
-UART2IntHandler(void) {
+static void
+UART_Receive(uint8_t idx) {
+    uint32_t base = uart_base[idx];
+    gps_buff_t* buff = &hgps_buff[idx];
 
     /* Make interrupt handler as fast as possible */
     uint32_t intStatus;
+    GPS_PROF_BEGIN(GPS_PROF_UART_ISR);
 
     // Retrieve masked interrupt status (only enabled interrupts).
-    intStatus = UARTIntStatus(UART2_BASE, true);
+    intStatus = UARTIntStatus(base, true);
 
 
     // Clear interrupt(s) after retrieval.
-    UARTIntClear(UART2_BASE, intStatus);
+    UARTIntClear(base, intStatus);
 
 
     // Important: Note that they're all IF statements. This is because you can have an NVIC
@@ -139,11 +267,11 @@ UART2IntHandler(void) {
     if((intStatus & UART_INT_RT) == UART_INT_RT)
         {
             // While there are bytes to read and there is space in the FIFO.
-            while(UARTCharsAvail(UART2_BASE) && (buff_get_free(&hgps_buff)>0))
+            while(UARTCharsAvail(base) && (buff_get_free(buff)>0))
             {
                 // Write a byte straight from the hardware FIFO into our Rx FIFO for processing later.
-                uint8_t data = (uint8_t)UARTCharGet(UART2_BASE);
-                buff_write(&hgps_buff, &data, 1);
+                uint8_t data = (uint8_t)UARTCharGet(base);
+                buff_write_stamped(buff, &data, 1, gps_prof_now());
 
             }
         }
@@ -152,11 +280,22 @@ UART2IntHandler(void) {
         if((intStatus & UART_INT_RX) == UART_INT_RX)
         {
             // While there are bytes to read and there is space in the FIFO.
-            while(UARTCharsAvail(UART2_BASE) && (buff_get_free(&hgps_buff)>0))
+            while(UARTCharsAvail(base) && (buff_get_free(buff)>0))
             {
                 // Write a byte straight from the hardware FIFO into our Rx FIFO for processing later.
-                 uint8_t data = (uint8_t)UARTCharGet(UART2_BASE);
-                 buff_write(&hgps_buff, &data, 1);
+                 uint8_t data = (uint8_t)UARTCharGet(base);
+                 buff_write_stamped(buff, &data, 1, gps_prof_now());
             }
         }
+    GPS_PROF_END(GPS_PROF_UART_ISR);
+}
+
+void
+UART2IntHandler(void) {
+    UART_Receive(0);
+}
+
+void
+UART1IntHandler(void) {
+    UART_Receive(1);
 }
@@ -0,0 +1,87 @@
+/*
+ * test_async.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ *
+ *  Behavior test of asynchronous source: every 10 Hz epoch is queued once,
+ *  also when several sentences arrive in one read.
+ *
+ *  Build:  cc -O2 -I.. -c ../gps.c ../gps_buff.c ../gps_prof.c && c++ -std=c++20 -O2 -I.. test_async.cpp gps.o gps_buff.o gps_prof.o -o test_async
+ *  Usage:  test_async, exit code is `0` when all checks pass
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "gps_async.hpp"
+
+static int failed;
+
+#define CHECK(expr)     do { if (!(expr)) { std::printf("%s:%d: %s\n", __FILE__, __LINE__, #expr); failed++; } } while (0)
+
+/**
+ * \brief           Build sentence with checksum and line end
+ * \param[in]       body: Sentence without `$` and checksum
+ */
+static std::string
+sentence(const std::string& body) {
+    char crc[8];
+    std::uint8_t c = 0;
+
+    for (char ch : body) {
+        c ^= static_cast<std::uint8_t>(ch);
+    }
+    std::snprintf(crc, sizeof(crc), "*%02X\r\n", c);
+    return "$" + body + crc;
+}
+
+/**
+ * \brief           Collect epochs of all fixes of source
+ */
+static gps::async::task
+collect(gps::async::source<>& src, std::vector<gps_epoch_t>& out) {
+    while (auto fix = co_await src.next()) {
+        out.push_back(fix->gga.epoch);
+    }
+}
+
+int
+main() {
+    std::vector<gps_epoch_t> epochs;
+    gps::async::reactor r;
+    std::string data;
+    char body[128];
+    int fd[2];
+
+    data = sentence("GPRMC,123455.90,A,4807.038,N,01131.000,E,0.0,0.0,181026,,");
+    for (int i = 0; i < 20; i++) {              /* 10 Hz, with other sentence between epochs */
+        std::snprintf(body, sizeof(body), "GPGGA,1234%02d.%02d,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,",
+            56 + i / 10, (i % 10) * 10);
+        data += sentence(body);
+        data += sentence("GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1");
+    }
+    CHECK(pipe(fd) == 0);
+    CHECK(write(fd[1], data.data(), data.size()) == static_cast<ssize_t>(data.size()));    /* All in one read */
+    close(fd[1]);
+
+    {
+        gps::async::source<> src(r, fd[0]);
+        collect(src, epochs);
+        r.run();
+        CHECK(src.closed() && src.error() == 0);
+    }
+    close(fd[0]);
+
+    CHECK(epochs.size() == 20);
+    for (std::size_t i = 1; i < epochs.size(); i++) {
+        CHECK(epochs[i] - epochs[i - 1] == 100000);
+    }
+
+    std::printf("%s\n", failed ? "FAIL" : "OK");
+    return failed != 0;
+}
@@ -0,0 +1,88 @@
+/*
+ * test_bcast.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ *
+ *  Behavior test of broadcast ring: slowest reader bounds writer, overruns and
+ *  lag are counted per reader, data stay intact over wrap of ring.
+ *
+ *  Build:  cc -O2 -std=c99 -I.. test_bcast.c ../gps_bcast.c -o test_bcast
+ *  Usage:  test_bcast, exit code is `0` when all checks pass
+ */
+
+#include <stdio.h>
+
+#include "gps_bcast.h"
+
+static int failed;
+
+#define CHECK(expr)     do { if (!(expr)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #expr); failed++; } } while (0)
+
+int
+main(void) {
+    static uint8_t data[16], in[64], out[64];
+    const uint8_t* p;
+    gps_bcast_t b;
+    uint8_t fast, slow, late, i;
+    size_t n, k;
+
+    for (i = 0; i < sizeof(in); i++) {
+        in[i] = i;
+    }
+    CHECK(bcast_init(&b, data, sizeof(data)));
+    CHECK(bcast_reader_add(&b, &fast));
+    CHECK(bcast_reader_add(&b, &slow));
+    CHECK(bcast_get_free(&b) == sizeof(data) - 1);
+
+    /* Fill ring, fast reader keeps up, slow reader reads nothing */
+    CHECK(bcast_write(&b, in, 15) == 15);
+    CHECK(bcast_read(&b, fast, out, sizeof(out)) == 15);
+    CHECK(memcmp(out, in, 15) == 0);
+    CHECK(bcast_get_full(&b, slow) == 15);
+    CHECK(bcast_get_free(&b) == 0);
+
+    /* Writer is blocked by slow reader, dropped bytes are its overruns only */
+    CHECK(bcast_write(&b, &in[15], 10) == 0);
+    CHECK(b.readers[slow].overruns == 10);
+    CHECK(b.readers[fast].overruns == 0);
+    CHECK(b.readers[slow].max_lag == 15);
+    CHECK(b.readers[fast].max_lag == 15);
+
+    /* Slow reader frees 5 bytes, writer fills them and drops the rest */
+    CHECK(bcast_skip(&b, slow, 5) == 5);
+    CHECK(bcast_write(&b, &in[15], 10) == 5);
+    CHECK(b.readers[slow].overruns == 15);
+    CHECK(b.readers[fast].overruns == 0);
+    CHECK(b.readers[fast].max_lag == 15);
+    CHECK(bcast_get_full(&b, fast) == 5);
+
+    /* Reader added late starts empty and sees only new data */
+    CHECK(bcast_reader_add(&b, &late));
+    CHECK(bcast_get_full(&b, late) == 0);
+
+    /* Removed slow reader no longer bounds writer */
+    bcast_reader_remove(&b, slow);
+    CHECK(bcast_get_full(&b, slow) == 0);
+    CHECK(bcast_get_free(&b) == sizeof(data) - 1 - 5);
+
+    /* Data stay intact over many wraps, read in linear blocks */
+    CHECK(bcast_read(&b, fast, out, sizeof(out)) == 5);
+    CHECK(memcmp(out, &in[15], 5) == 0);
+    for (k = 0; k < 40; k++) {
+        CHECK(bcast_write(&b, &in[k], 7) == 7);
+        n = bcast_get_linear_block(&b, fast, &p);
+        CHECK(n > 0 && n <= 7);
+        CHECK(memcmp(p, &in[k], n) == 0);
+        CHECK(bcast_read(&b, late, out, 7) == 7);
+        CHECK(memcmp(out, &in[k], 7) == 0);
+        CHECK(bcast_read(&b, fast, out, 7) == 7);
+        CHECK(memcmp(out, &in[k], 7) == 0);
+    }
+    CHECK(b.readers[fast].overruns == 0);
+    CHECK(b.readers[late].overruns == 0);
+    CHECK(b.readers[late].max_lag == 7);
+
+    printf("%s\n", failed ? "FAIL" : "OK");
+    return failed != 0;
+}
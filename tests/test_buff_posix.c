@@ -0,0 +1,131 @@
+/*
+ * test_buff_posix.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: junaidkhan
+ *
+ *  Behavior test of POSIX wait/notify backends: reader waiting on condition variable
+ *  or `eventfd` is woken up by writer thread well before timeout, and returns `0`
+ *  once timeout expires without data, also after stale notification.
+ *  Timeouts are checked by backend alone (no profiling clock) and by buffer with clock.
+ *
+ *  Build:  cc -O2 -std=c99 -I.. test_buff_posix.c ../gps_buff.c ../gps_buff_posix.c ../gps_prof.c -lpthread -o test_buff_posix
+ *  Usage:  test_buff_posix, exit code is `0` when all checks pass
+ */
+
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE     200809L             /* clock_gettime, nanosleep */
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "gps_buff_posix.h"
+#include "gps_prof.h"
+
+#define LINE            "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n"
+#define TIMEOUT_MS      100
+#define WRITE_DELAY_MS  20
+#define LATE_MS         1000                    /* Slow scheduling of busy machine is not an error */
+
+static int failed;
+
+#define CHECK(expr)     do { if (!(expr)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #expr); failed++; } } while (0)
+
+/**
+ * \brief           Get monotonic time in units of milliseconds
+ */
+static long
+now_ms(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long)ts.tv_sec * 1000L + ts.tv_nsec / 1000000L;
+}
+
+/**
+ * \brief           Writer thread, writes one sentence after short delay
+ * \param[in]       arg: Buffer handle
+ */
+static void*
+writer(void* arg) {
+    struct timespec d = {0, WRITE_DELAY_MS * 1000000L};
+
+    nanosleep(&d, NULL);
+    buff_write(arg, LINE, sizeof(LINE) - 1);
+    return NULL;
+}
+
+/**
+ * \brief           Run all cases with one backend
+ * \param[in]       w: Initialized backend
+ */
+static void
+run(gps_buff_waiter_t* w) {
+    static uint8_t data[256];
+    gps_buff_t b;
+    pthread_t th;
+    uint8_t tmp[sizeof(LINE)];
+    long t0, dt;
+
+    CHECK(buff_init(&b, data, sizeof(data)));
+    CHECK(buff_set_waiter(&b, w));
+
+    /* Nothing written, wait ends at timeout */
+    t0 = now_ms();
+    CHECK(buff_wait(&b, 1, TIMEOUT_MS) == 0);
+    dt = now_ms() - t0;
+    CHECK(dt >= TIMEOUT_MS - 1 && dt < LATE_MS);
+
+    /* Writer wakes up reader before timeout */
+    t0 = now_ms();
+    CHECK(pthread_create(&th, NULL, writer, &b) == 0);
+    CHECK(buff_wait_eol(&b, 10 * LATE_MS) == sizeof(LINE) - 1);
+    dt = now_ms() - t0;
+    CHECK(dt >= WRITE_DELAY_MS - 1 && dt < LATE_MS);
+    pthread_join(th, NULL);
+    CHECK(buff_read(&b, tmp, sizeof(tmp)) == sizeof(LINE) - 1);
+
+    /* Same without limit */
+    CHECK(pthread_create(&th, NULL, writer, &b) == 0);
+    CHECK(buff_wait_eol(&b, GPS_BUFF_WAIT_FOREVER) == sizeof(LINE) - 1);
+    pthread_join(th, NULL);
+    CHECK(buff_read(&b, tmp, sizeof(tmp)) == sizeof(LINE) - 1);
+
+    /* Data already read, stale notification does not end wait early */
+    buff_write(&b, "$GP", 3);
+    CHECK(buff_read(&b, tmp, sizeof(tmp)) == 3);
+    t0 = now_ms();
+    CHECK(buff_wait(&b, 1, TIMEOUT_MS) == 0);
+    dt = now_ms() - t0;
+    CHECK(dt >= TIMEOUT_MS - 1 && dt < LATE_MS);
+
+    /* Data waiting, no wait at all */
+    buff_write(&b, LINE, sizeof(LINE) - 1);
+    t0 = now_ms();
+    CHECK(buff_wait_eol(&b, TIMEOUT_MS) == sizeof(LINE) - 1);
+    CHECK(now_ms() - t0 < TIMEOUT_MS);
+}
+
+int
+main(void) {
+    gps_buff_cond_waiter_t cw;
+    gps_buff_eventfd_waiter_t ew;
+    int with_clock;
+
+    CHECK(buff_cond_waiter_init(&cw));
+    CHECK(buff_eventfd_waiter_init(&ew));
+    for (with_clock = 0; with_clock < 2; with_clock++) {  /* Timeout of backend first, then of buffer */
+        if (with_clock) {
+            CHECK(gps_prof_init());
+        }
+        run(&cw.ops);
+        run(&ew.ops);
+    }
+    buff_cond_waiter_free(&cw);
+    buff_eventfd_waiter_free(&ew);
+
+    printf("%s\n", failed ? "FAIL" : "OK");
+    return failed != 0;
+}
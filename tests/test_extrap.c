@@ -0,0 +1,111 @@
+/*
+ * test_extrap.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ *
+ *  Behavior test of position extrapolator with 32-bit ticks of 80 MHz clock:
+ *  state stays stale and next fix restarts filter after gap longer than
+ *  one tick counter period (53.7 s), jump of epoch when date becomes known is no gap.
+ *
+ *  Build:  cc -O2 -std=c99 -I.. test_extrap.c ../gps_extrap.c ../gps_prof.c -lm -o test_extrap
+ *  Usage:  test_extrap, exit code is `0` when all checks pass
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "gps_extrap.h"
+#include "gps_prof.h"
+
+#define TPS             80000000UL              /* Cycle counter of target */
+#define PERIOD          (4294967296.0 / TPS)    /* Seconds until 32-bit tick counter wraps */
+#define EPOCH_US        1792326896000000ULL     /* 2026-10-18 12:34:56 */
+
+static int failed;
+
+#define CHECK(expr)     do { if (!(expr)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #expr); failed++; } } while (0)
+
+/**
+ * \brief           Get 32-bit tick at given time
+ * \param[in]       sec: Time in units of seconds
+ */
+static gps_tick_t
+tick(double sec) {
+    return (gps_tick_t)(uint32_t)(uint64_t)(sec * TPS);
+}
+
+/**
+ * \brief           Unused clock, test passes ticks directly
+ */
+static gps_tick_t
+clock_fn(void) {
+    return 0;
+}
+
+int
+main(void) {
+    gps_extrap_t x;
+    gps_fix_t fix;
+    gps_float_t lat, v;
+    double t;
+
+    gps_prof_set_clock(clock_fn, TPS);
+    gps_extrap_init(&x);
+    memset(&fix, 0x00, sizeof(fix));
+    fix.gga.fix = 1;
+    fix.gga.latitude = 48.0;
+    fix.gga.longitude = 11.0;
+    fix.gga.epoch = EPOCH_US;
+    fix.gga.timed = 1;
+    fix.gga.dated = 1;
+
+    /* Receiver moving north at 10 m/s, fixes 1 s apart */
+    for (t = 0; t < 10; t += 1) {
+        fix.gga.latitude = 48.0 + 10.0 * t / 111194.9;
+        fix.gga.epoch = EPOCH_US + (gps_epoch_t)(t * 1e6);
+        CHECK(gps_extrap_update(&x, &fix, tick(t)));
+    }
+    CHECK(x.vn > 9.0 && x.vn < 11.0);
+    CHECK(gps_extrap_get(&x, tick(9.5), &lat, NULL, NULL));
+
+    /* Fix stream stops, state goes stale and stays so after counter wraps */
+    CHECK(!gps_extrap_get(&x, tick(12.0), &lat, NULL, NULL));
+    for (t = 13.0; t < 9.0 + PERIOD + 1.0; t += 1.0) {
+        CHECK(!gps_extrap_get(&x, tick(t), &lat, NULL, NULL));
+    }
+    CHECK(!gps_extrap_get(&x, tick(9.0 + PERIOD + 0.5), &lat, NULL, NULL));  /* Same ticks as 0.5 s age */
+
+    /* Next fix comes one counter period plus 1 s later, 700 m further, looks 1 s old in ticks */
+    t = 10.0 + PERIOD;
+    fix.gga.latitude = 48.0 + 700.0 / 111194.9;
+    fix.gga.epoch = EPOCH_US + (gps_epoch_t)(t * 1e6);
+    CHECK(gps_extrap_update(&x, &fix, tick(t)));
+    CHECK(x.latitude == fix.gga.latitude);     /* Restarted from measurement */
+    CHECK(x.vn == 0);
+    CHECK(gps_extrap_get(&x, tick(t + 0.5), &lat, NULL, NULL));
+    CHECK(lat == fix.gga.latitude);
+
+    /* Filter continues normally after restart */
+    fix.gga.latitude += 10.0 / 111194.9;
+    fix.gga.epoch += 1000000U;
+    CHECK(gps_extrap_update(&x, &fix, tick(t + 1.0)));
+    v = x.vn;
+    CHECK(v > 0 && v < 11.0);
+    CHECK(gps_extrap_get(&x, tick(t + 1.5), &lat, NULL, NULL));
+
+    /* Receiver without date counts from day `0`, date known 1 s later moves epoch by years */
+    gps_extrap_init(&x);
+    fix.gga.dated = 0;
+    fix.gga.epoch = EPOCH_US % (86400ULL * 1000000ULL);
+    CHECK(gps_extrap_update(&x, &fix, tick(t + 2.0)));
+    fix.gga.latitude += 10.0 / 111194.9;
+    fix.gga.dated = 1;
+    fix.gga.epoch = EPOCH_US + 1000000U;
+    CHECK(gps_extrap_update(&x, &fix, tick(t + 3.0)));
+    CHECK(x.vn > 0);                            /* Filter continued, not restarted */
+
+    printf("%s\n", failed ? "FAIL" : "OK");
+    return failed != 0;
+}
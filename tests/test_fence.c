@@ -0,0 +1,153 @@
+/*
+ * test_fence.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: junaidkhan
+ *
+ *  Behavior test of geofence index against brute force over all edges and circles:
+ *  containment, violated zones, distance and nearest zone agree for random
+ *  non-convex polygons, inside and outside of grid.
+ *
+ *  Build:  cc -O2 -std=c99 -I.. test_fence.c ../gps_fence.c -lm -o test_fence
+ *  Usage:  test_fence, exit code is `0` when all checks pass
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "gps_fence.h"
+
+#define REF_LAT         32.990254
+#define REF_LON         -106.975041
+#define FENCES          20
+#define POINTS          5000
+#define SPAN            8000.0                  /* Points are within this distance of reference, grid is smaller */
+#define EDGE_TOL        0.05                    /* Points closer to boundary are not checked for containment */
+#define PI              3.14159265358979323846
+
+static int failed;
+
+#define CHECK(expr)     do { if (!(expr)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #expr); failed++; } } while (0)
+
+static uint32_t seed = 1;
+
+/**
+ * \brief           Get uniform random number in range `[a, b)`
+ */
+static double
+rnd(double a, double b) {
+    seed = seed * 1103515245UL + 12345UL;
+    return a + (b - a) * (double)((seed >> 8) & 0xFFFFFF) / 16777216.0;
+}
+
+/**
+ * \brief           Add random star shaped polygon, vertices sorted by angle around center
+ * \param[in]       f: Geofence handle
+ * \param[in]       kind: Zone kind
+ * \param[in]       cx, cy: Center east and north of reference, in meters
+ * \param[in]       r0, r1: Range of vertex distance from center, in meters
+ * \param[in]       n: Number of vertices
+ */
+static void
+add_star(gps_fence_t* f, gps_fence_kind_t kind, double cx, double cy, double r0, double r1, size_t n) {
+    gps_float_t lat[16], lon[16];
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        double a = (i + rnd(0.1, 0.9)) * 2 * PI / n, r = rnd(r0, r1);
+        lon[i] = f->ref_lon + (cx + r * cos(a)) / f->kx;
+        lat[i] = f->ref_lat + (cy + r * sin(a)) / f->ky;
+    }
+    CHECK(gps_fence_add_polygon(f, kind, lat, lon, n, NULL));
+}
+
+/**
+ * \brief           Check one position against brute force
+ */
+static void
+check_point(const gps_fence_t* f, double px, double py) {
+    gps_fence_result_t res;
+    double best = 1e300, d;
+    uint32_t inside = 0, violated;
+    uint16_t k;
+    uint8_t i, nearest = 0xFF;
+
+    for (k = 0; k < f->edge_count; k++) {
+        const gps_fence_edge_t* e = &f->edges[k];
+        double dx = (double)e->bx - e->ax, dy = (double)e->by - e->ay;
+        double t = ((px - e->ax) * dx + (py - e->ay) * dy) / (dx * dx + dy * dy);
+
+        t = t < 0 ? 0 : (t > 1 ? 1 : t);
+        d = hypot(e->ax + t * dx - px, e->ay + t * dy - py);
+        if (d < best) {
+            best = d;
+            nearest = e->zone;
+        }
+        if ((e->ay > py) != (e->by > py)
+            && px < e->ax + (py - e->ay) * ((double)e->bx - e->ax) / ((double)e->by - e->ay)) {
+            inside ^= 1UL << e->zone;
+        }
+    }
+    for (i = 0; i < f->zone_count; i++) {
+        const gps_fence_zone_t* z = &f->zones[i];
+        if (z->r > 0) {
+            d = hypot(px - z->cx, py - z->cy) - z->r;
+            if (d < 0) {
+                inside |= 1UL << i;
+            }
+            if (fabs(d) < best) {
+                best = fabs(d);
+                nearest = i;
+            }
+        }
+    }
+    violated = inside & ~f->keep_in;
+    if (f->keep_in && !(inside & f->keep_in)) {
+        violated |= f->keep_in;
+    }
+
+    CHECK(gps_fence_check(f, f->ref_lat + py / f->ky, f->ref_lon + px / f->kx, &res));
+    if (fabs(res.dist - best) > 0.01 + 1e-5 * best) {
+        printf("dist %.3f brute %.3f at %.1f %.1f\n", (double)res.dist, best, px, py);
+        failed++;
+        return;
+    }
+    if (best > EDGE_TOL) {
+        CHECK(res.inside == inside);
+        CHECK(res.violated == violated);
+    }
+    if (res.nearest != nearest) {               /* Equal distance of two zones may pick either */
+        CHECK(fabs(res.dist - best) < 0.01);
+    }
+}
+
+int
+main(void) {
+    static gps_fence_t f;
+    size_t n, p, outside = 0;
+
+    for (n = 0; n < FENCES; n++) {
+        gps_fence_init(&f, REF_LAT, REF_LON);
+        add_star(&f, GPS_FENCE_KEEP_IN, 0, 0, 2500, 5000, 16);
+        add_star(&f, GPS_FENCE_KEEP_OUT, rnd(-2000, 2000), rnd(-2000, 2000), 100, 800, 12);
+        add_star(&f, GPS_FENCE_KEEP_OUT, rnd(-2000, 2000), rnd(-2000, 2000), 100, 800, 12);
+        add_star(&f, GPS_FENCE_KEEP_IN, rnd(-6000, 6000), rnd(-6000, 6000), 200, 1200, 10);
+        CHECK(gps_fence_add_circle(&f, GPS_FENCE_KEEP_OUT, REF_LAT + rnd(-1500, 1500) / f.ky,
+            REF_LON + rnd(-1500, 1500) / f.kx, rnd(50, 400), NULL));
+        CHECK(gps_fence_compile(&f));
+
+        for (p = 0; p < POINTS; p++) {
+            double px = rnd(-SPAN, SPAN), py = rnd(-SPAN, SPAN);
+
+            outside += px < f.x0 || py < f.y0 || px >= f.x0 + GPS_CFG_FENCE_GRID * f.cw
+                || py >= f.y0 + GPS_CFG_FENCE_GRID * f.ch;
+            check_point(&f, px, py);
+        }
+        check_point(&f, f.zones[4].cx, f.zones[4].cy);  /* Center of circle */
+    }
+    CHECK(outside > 0 && outside < FENCES * POINTS);  /* Both paths were taken */
+
+    printf("%s\n", failed ? "FAIL" : "OK");
+    return failed != 0;
+}
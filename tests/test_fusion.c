@@ -0,0 +1,125 @@
+/*
+ * test_fusion.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ *
+ *  Behavior test of fusion stage: receivers are fused per sub-second epoch,
+ *  and receiver which has no date yet is fused with one which has it.
+ *
+ *  Build:  cc -O2 -std=c99 -I.. test_fusion.c ../gps.c ../gps_buff.c ../gps_prof.c ../gps_fusion.c -lm -o test_fusion
+ *  Usage:  test_fusion, exit code is `0` when all checks pass
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "gps_fusion.h"
+
+#define US_PER_SEC      1000000ULL
+#define EPOCH_DAY       20744ULL                /* 2026-10-18, days since 1970-01-01 */
+
+static int failed;
+
+#define CHECK(expr)     do { if (!(expr)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #expr); failed++; } } while (0)
+
+/**
+ * \brief           Pass sentence to parser, with checksum and line end added
+ * \param[in]       gh: GPS handle
+ * \param[in]       body: Sentence without `$` and checksum
+ */
+static void
+feed(gps_t* gh, const char* body) {
+    char line[128];
+    uint8_t crc = 0;
+    size_t i;
+
+    for (i = 0; body[i] != '\0'; i++) {
+        crc ^= (uint8_t)body[i];
+    }
+    snprintf(line, sizeof(line), "$%s*%02X\r\n", body, (unsigned)crc);
+    gps_process(gh, line, strlen(line));
+}
+
+/**
+ * \brief           Pass GGA sentence with given time of day to parser
+ * \param[in]       gh: GPS handle
+ * \param[in]       tod: Time field, `hhmmss.ss`
+ */
+static void
+feed_gga(gps_t* gh, const char* tod) {
+    char body[96];
+
+    snprintf(body, sizeof(body), "GPGGA,%s,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,", tod);
+    feed(gh, body);
+}
+
+int
+main(void) {
+    static gps_t rx[2];
+    gps_t* prx[2] = { &rx[0], &rx[1] };
+    gps_fusion_out_t out;
+    gps_fusion_t f;
+    gps_epoch_t day_us = EPOCH_DAY * 86400ULL * US_PER_SEC;
+    gps_epoch_t tod = (12ULL * 3600 + 34 * 60 + 56) * US_PER_SEC;
+    int n;
+
+    gps_init(&rx[0]);
+    gps_init(&rx[1]);
+    CHECK(gps_fusion_init(&f, prx, 2));
+
+    /* Receiver 0 has date from RMC, receiver 1 only sends GGA and counts days from 0 */
+    feed(&rx[0], "GPRMC,123455.00,A,4807.038,N,01131.000,E,0.0,0.0,181026,,");
+    feed_gga(&rx[0], "123456.00");
+    feed_gga(&rx[1], "123456.00");
+    CHECK(gps_gga(&rx[0])->epoch == day_us + tod);
+    CHECK(gps_gga(&rx[1])->epoch == tod);
+    CHECK(gps_gga(&rx[0])->dated && !gps_gga(&rx[1])->dated);
+    CHECK(gps_fusion_update(&f, &out));
+    CHECK(out.used == 0x03);
+    CHECK(out.fix.gga.epoch == day_us + tod);
+    CHECK(out.fix.gga.dated);
+    CHECK(!gps_fusion_update(&f, &out));
+
+    /* 10 Hz epochs are fused separately, not merged by whole second */
+    feed_gga(&rx[0], "123456.10");
+    feed_gga(&rx[1], "123456.10");
+    CHECK(gps_fusion_update(&f, &out));
+    CHECK(out.used == 0x03);
+    CHECK(out.fix.gga.epoch == day_us + tod + 100000);
+    feed_gga(&rx[0], "123456.20");
+    feed_gga(&rx[1], "123456.20");
+    CHECK(gps_fusion_update(&f, &out));
+    CHECK(out.used == 0x03);
+    CHECK(out.fix.gga.epoch == day_us + tod + 200000);
+
+    /* Late epoch of one receiver is not published again */
+    feed_gga(&rx[0], "123456.30");
+    CHECK(!gps_fusion_update(&f, &out));
+    feed_gga(&rx[0], "123456.40");
+    CHECK(gps_fusion_update(&f, &out));         /* 0.3 s published alone when receiver 0 moved on */
+    CHECK(out.used == 0x01);
+    feed_gga(&rx[1], "123456.30");
+    CHECK(!gps_fusion_update(&f, &out));
+    feed_gga(&rx[1], "123456.40");
+    CHECK(gps_fusion_update(&f, &out));
+    CHECK(out.used == 0x03);
+    CHECK(out.fix.gga.epoch == day_us + tod + 400000);
+
+    /* Both receivers keep fusing across midnight, receiver 1 rolls its own day */
+    feed(&rx[0], "GPRMC,235959.90,A,4807.038,N,01131.000,E,0.0,0.0,181026,,");
+    for (n = 0; n < 2; n++) {
+        feed_gga(&rx[n], "235959.90");
+    }
+    CHECK(gps_fusion_update(&f, &out));
+    CHECK(out.used == 0x03);
+    for (n = 0; n < 2; n++) {
+        feed_gga(&rx[n], "000000.00");
+    }
+    CHECK(gps_fusion_update(&f, &out));
+    CHECK(out.used == 0x03);
+    CHECK(out.fix.gga.epoch == day_us + 86400ULL * US_PER_SEC);
+
+    printf("%s\n", failed ? "FAIL" : "OK");
+    return failed != 0;
+}
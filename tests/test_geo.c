@@ -0,0 +1,117 @@
+/*
+ * test_geo.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: junaidkhan
+ *
+ *  Behavior test of geodesy kernels: Vincenty distance and initial bearing of
+ *  Flinders Peak to Buninyong, and geodetic to ENU round trip at batch sizes
+ *  around vector width, where main loop and remainder of vectorized kernels meet.
+ *
+ *  Build:  cc -O3 -std=c99 -ffast-math -march=x86-64-v3 -I.. test_geo.c ../gps_geo.c -lm -o test_geo
+ *  Usage:  test_geo, exit code is `0` when all checks pass
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include "gps_geo.h"
+
+#define REF_LAT         32.990254
+#define REF_LON         -106.975041
+#define REF_ALT         1401.0
+#define MAX_N           40
+#define WGS84_A         6378137.0
+#define WGS84_F         (1.0 / 298.257223563)
+#define WGS84_E2        (WGS84_F * (2 - WGS84_F))
+#define DEG_TO_RAD      0.017453292519943295
+
+static int failed;
+
+#define CHECK(expr)     do { if (!(expr)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #expr); failed++; } } while (0)
+
+/**
+ * \brief           Convert degrees, minutes and seconds to degrees
+ */
+static double
+dms(double d, double m, double s) {
+    return d < 0 ? d - m / 60 - s / 3600 : d + m / 60 + s / 3600;
+}
+
+/**
+ * \brief           Convert local east-north-up of reference point back to geodetic coordinates,
+ *                  rotation to ECEF followed by Bowring iteration
+ * \param[in]       ref: Reference point
+ * \param[in]       e, n, u: East, north and up coordinates in meters
+ * \param[out]      lat, lon, alt: Latitude and longitude in degrees, altitude in meters
+ */
+static void
+enu_to_geo(const gps_geo_ref_t* ref, double e, double n, double u, double* lat, double* lon, double* alt) {
+    double sp = ref->sin_lat, cp = ref->cos_lat, sl = ref->sin_lon, cl = ref->cos_lon;
+    double x = ref->x - sl * e - sp * cl * n + cp * cl * u;
+    double y = ref->y + cl * e - sp * sl * n + cp * sl * u;
+    double z = ref->z + cp * n + sp * u;
+    double p = hypot(x, y), phi = atan2(z, p * (1 - WGS84_E2)), nr = WGS84_A;
+    int i;
+
+    for (i = 0; i < 10; i++) {
+        nr = WGS84_A / sqrt(1 - WGS84_E2 * sin(phi) * sin(phi));
+        phi = atan2(z + WGS84_E2 * nr * sin(phi), p);
+    }
+    *lat = phi / DEG_TO_RAD;
+    *lon = atan2(y, x) / DEG_TO_RAD;
+    *alt = p / cos(phi) - nr;
+}
+
+int
+main(void) {
+    static const size_t sizes[] = {1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, MAX_N};
+    gps_float_t lat[MAX_N], lon[MAX_N], alt[MAX_N], e[MAX_N], nn[MAX_N], u[MAX_N];
+    gps_float_t x[MAX_N], y[MAX_N], z[MAX_N], e1[MAX_N], n1[MAX_N], u1[MAX_N];
+    gps_float_t d, brg;
+    gps_geo_ref_t ref;
+    size_t s, i;
+
+    /* Flinders Peak to Buninyong, Vincenty 1975 */
+    d = gps_geo_vincenty(dms(-37, 57, 3.72030), dms(144, 25, 29.52440),
+            dms(-37, 39, 10.15610), dms(143, 55, 35.38390), &brg);
+    CHECK(fabs(d - 54972.271) < 0.001);
+    CHECK(fabs(brg - dms(306, 52, 5.37)) < 0.01 / 3600);
+
+    /* Same point has zero distance */
+    d = gps_geo_vincenty(REF_LAT, REF_LON, REF_LAT, REF_LON, &brg);
+    CHECK(d == 0 && brg == 0);
+
+    /* Points up to some kilometers away, at every batch size */
+    gps_geo_ref_init(&ref, REF_LAT, REF_LON, REF_ALT);
+    for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t n = sizes[s];
+
+        for (i = 0; i < n; i++) {
+            lat[i] = REF_LAT + 0.05 * sin(1.3 * (i + s));
+            lon[i] = REF_LON + 0.07 * cos(0.7 * (i + s));
+            alt[i] = REF_ALT + 300.0 * sin(0.9 * (i + s));
+            e[i] = nn[i] = u[i] = NAN;
+        }
+        gps_geo_to_enu(&ref, lat, lon, alt, e, nn, u, n);
+        gps_geo_to_ecef(lat, lon, alt, x, y, z, n);
+        gps_geo_ecef_to_enu(&ref, x, y, z, e1, n1, u1, n);
+
+        for (i = 0; i < n; i++) {
+            double la, lo, al;
+
+            enu_to_geo(&ref, e[i], nn[i], u[i], &la, &lo, &al);
+            if (!(fabs(la - lat[i]) < 1e-9 && fabs(lo - lon[i]) < 1e-9 && fabs(al - alt[i]) < 1e-4)) {
+                printf("n %lu, point %lu: %.9f %.9f %.4f back to %.9f %.9f %.4f\n", (unsigned long)n,
+                    (unsigned long)i, (double)lat[i], (double)lon[i], (double)alt[i], la, lo, al);
+                failed++;
+            }
+
+            /* Fused kernel is the same as two step conversion */
+            CHECK(fabs(e[i] - e1[i]) < 1e-4 && fabs(nn[i] - n1[i]) < 1e-4 && fabs(u[i] - u1[i]) < 1e-4);
+        }
+    }
+
+    printf("%s\n", failed ? "FAIL" : "OK");
+    return failed != 0;
+}
@@ -0,0 +1,106 @@
+/*
+ * test_gsv.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: junaidkhan
+ *
+ *  Behavior test of constellation talkers: GP, GL, GA, GB and BD statements are
+ *  accepted, satellites in view are kept per constellation and summed,
+ *  combined GN position is accepted and GN GSV is ignored.
+ *  Stream is output of `gps_gen -t GP,GL,GA,GB -d 1 -r 1`.
+ *
+ *  Build:  cc -O2 -std=c99 -I.. -DGPS_CFG_STATEMENT_GPGSV=1 -DGPS_CFG_STATS=1 test_gsv.c ../gps.c ../gps_buff.c ../gps_prof.c -lm -o test_gsv
+ *  Usage:  test_gsv, exit code is `0` when all checks pass
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "gps.h"
+
+static const char gen[] =
+    "$GNGGA,175950.00,3259.4165,N,10658.4998,W,1,27,0.8,1401.2,M,-22.4,M,,*70\r\n"
+    "$GNRMC,175950.00,A,3259.4165,N,10658.4998,W,0.00,0.0,200626,,,A*60\r\n"
+    "$GNVTG,0.0,T,,M,0.00,N,0.00,K,A*13\r\n"
+    "$GPGSA,A,3,02,26,09,01,04,08,14,22,,,,,1.5,0.8,1.3*3B\r\n"
+    "$GLGSA,A,3,79,66,76,81,80,83,,,,,,,1.5,0.8,1.3*25\r\n"
+    "$GAGSA,A,3,02,24,22,18,13,,,,,,,,1.5,0.8,1.3*22\r\n"
+    "$GBGSA,A,3,22,02,19,52,17,61,48,09,,,,,1.5,0.8,1.3*27\r\n"
+    "$GPGSV,3,1,10,02,64,349,39,26,66,315,37,09,68,145,39,01,47,156,41*71\r\n"
+    "$GPGSV,3,2,10,04,70,245,40,07,11,178,26,32,08,185,29,08,84,215,47*7F\r\n"
+    "$GPGSV,3,3,10,14,40,091,36,22,64,294,41*7C\r\n"
+    "$GLGSV,2,1,07,79,61,085,40,66,72,116,43,76,78,108,46,81,80,141,46*67\r\n"
+    "$GLGSV,2,2,07,80,17,345,30,77,10,270,26,83,27,013,31*53\r\n"
+    "$GAGSV,2,1,06,14,14,058,30,02,60,203,38,24,73,290,39,22,22,152,33*68\r\n"
+    "$GAGSV,2,2,06,18,80,270,44,13,64,280,44*60\r\n"
+    "$GBGSV,2,1,08,22,81,214,47,02,72,000,42,19,52,239,39,52,56,010,37*60\r\n"
+    "$GBGSV,2,2,08,17,35,053,35,61,19,036,29,48,42,202,34,09,82,171,46*69\r\n";
+
+static int failed;
+
+#define CHECK(expr)     do { if (!(expr)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #expr); failed++; } } while (0)
+
+/**
+ * \brief           Pass sentence with correct checksum to parser
+ * \param[in]       gh: GPS handle
+ * \param[in]       body: Sentence between `$` and `*`
+ */
+static void
+feed(gps_t* gh, const char* body) {
+    char line[128];
+    uint8_t crc = 0;
+    const char* c;
+
+    for (c = body; *c; c++) {
+        crc ^= (uint8_t)*c;
+    }
+    snprintf(line, sizeof(line), "$%s*%02X\r\n", body, crc);
+    gps_process(gh, line, strlen(line));
+}
+
+int
+main(void) {
+    static gps_t gh;
+    gps_stats_t st;
+    gps_fix_t fix;
+
+    /* Combined GN position and date, GSV of each constellation */
+    gps_init(&gh);
+    gps_process(&gh, gen, sizeof(gen) - 1);
+    CHECK(gps_get_fix(&gh, &fix));
+    CHECK(fix.gga.fix == 1 && fix.gga.sats_in_use == 27);
+    CHECK(fix.rmc.date == 20 && fix.rmc.month == 6 && fix.rmc.year == 26);
+    CHECK(gh.sats_in_view[GPS_SYSTEM_GPS] == 10);
+    CHECK(gh.sats_in_view[GPS_SYSTEM_GLONASS] == 7);
+    CHECK(gh.sats_in_view[GPS_SYSTEM_GALILEO] == 6);
+    CHECK(gh.sats_in_view[GPS_SYSTEM_BEIDOU] == 8);
+    CHECK(gh.sats_in_view_total == 31);
+    CHECK(gps_get_stats(&gh, &st));
+    CHECK(st.published == 2 + 9 && st.ignored == 5);
+    CHECK(st.crc_errors == 0 && st.format_errors == 0);
+
+    /* BD is BeiDou too, new count replaces previous one */
+    feed(&gh, "BDGSV,1,1,03,22,81,214,47,02,72,000,42,19,52,239,39");
+    CHECK(gh.sats_in_view[GPS_SYSTEM_BEIDOU] == 3);
+    CHECK(gh.sats_in_view_total == 26);
+
+    /* GN satellites belong to no single constellation, counts stay */
+    feed(&gh, "GNGSV,1,1,04,22,81,214,47,02,72,000,42,19,52,239,39,79,61,085,40");
+    CHECK(gh.sats_in_view_total == 26);
+    CHECK(gps_get_stats(&gh, &st));
+    CHECK(st.published == 2 + 10 && st.ignored == 6);
+
+    /* Unknown talker is ignored */
+    feed(&gh, "QZGSV,1,1,01,193,81,214,47");
+    CHECK(gh.sats_in_view_total == 26);
+    CHECK(gps_get_stats(&gh, &st));
+    CHECK(st.ignored == 7);
+
+    /* Constellation with no satellites in view */
+    feed(&gh, "GLGSV,1,1,00");
+    CHECK(gh.sats_in_view[GPS_SYSTEM_GLONASS] == 0);
+    CHECK(gh.sats_in_view_total == 19);
+
+    printf("%s\n", failed ? "FAIL" : "OK");
+    return failed != 0;
+}
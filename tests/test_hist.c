@@ -0,0 +1,77 @@
+/*
+ * test_hist.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ *
+ *  Behavior test of fix history: fix without time is ignored, undated midnight
+ *  is valid epoch, sub-second epochs are kept apart, climb rate follows 10 Hz
+ *  fixes, first fix after date becomes known gives no velocity.
+ *
+ *  Build:  cc -O2 -std=c99 -I.. test_hist.c ../gps_hist.c -lm -o test_hist
+ *  Usage:  test_hist, exit code is `0` when all checks pass
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "gps_hist.h"
+
+#define US_PER_SEC      1000000ULL
+#define EPOCH_DAY       20744ULL                /* 2026-10-18, days since 1970-01-01 */
+
+static int failed;
+
+#define CHECK(expr)     do { if (!(expr)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #expr); failed++; } } while (0)
+#define NEAR(a, b)      (fabs((double)(a) - (double)(b)) < 1e-3)
+
+int
+main(void) {
+    static gps_hist_t h;
+    gps_float_t vu, t;
+    gps_gga_t g;
+    int i;
+
+    gps_hist_init(&h);
+    memset(&g, 0x00, sizeof(g));
+    g.fix = 1;
+    g.latitude = 48.1173;
+    g.longitude = 11.5167;
+
+    /* Fix without time is ignored, undated midnight is valid epoch `0` */
+    CHECK(!gps_hist_push(&h, &g));
+    g.timed = 1;
+    CHECK(gps_hist_push(&h, &g));
+    CHECK(gps_hist_count(&h) == 1);
+    gps_hist_init(&h);
+
+    /* Undated epochs at 10 Hz, climbing 1 m per fix */
+    for (i = 0; i < 10; i++) {
+        g.epoch = 45296ULL * US_PER_SEC + (gps_epoch_t)i * 100000U;
+        g.altitude = (gps_aux_float_t)(100 + i);
+        CHECK(gps_hist_push(&h, &g));
+    }
+    CHECK(!gps_hist_push(&h, &g));              /* Same epoch again */
+    CHECK(gps_hist_count(&h) == 10);
+    CHECK(gps_hist_velocity(&h, NULL, NULL, &vu) && NEAR(vu, 10.0));
+    CHECK(NEAR(gps_hist_climb_avg(&h), 10.0));
+    CHECK(NEAR(gps_hist_alt_max(&h, &t), 109.0));
+    CHECK(NEAR(t, 45296.9));
+
+    /* Date becomes known, epoch moves to new time base: no velocity to undated fix */
+    g.dated = 1;
+    g.epoch = (EPOCH_DAY * 86400ULL + 45297ULL) * US_PER_SEC;
+    g.altitude = 110;
+    CHECK(gps_hist_push(&h, &g));
+    CHECK(gps_hist_velocity(&h, NULL, NULL, &vu) && NEAR(vu, 0.0));
+
+    /* Next dated fix 0.1 s later gives velocity again */
+    g.epoch += 100000U;
+    g.altitude = 111;
+    CHECK(gps_hist_push(&h, &g));
+    CHECK(gps_hist_velocity(&h, NULL, NULL, &vu) && NEAR(vu, 10.0));
+
+    printf("%s\n", failed ? "FAIL" : "OK");
+    return failed != 0;
+}
@@ -0,0 +1,143 @@
+/*
+ * test_hpp.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: junaidkhan
+ *
+ *  Behavior test of C++ parser against C parser: both publish the same values
+ *  after every line of damaged stream. Lines with dropped bytes whose wrong checksum
+ *  happens to match are accepted by both, so malformed terms must be read alike.
+ *  Hand written cases always run, generated stream is checked when given.
+ *
+ *  Build:  cc -O2 -I.. -c ../gps.c ../gps_buff.c ../gps_prof.c && c++ -std=c++20 -O2 -I.. test_hpp.cpp gps.o gps_buff.o gps_prof.o -o test_hpp
+ *  Usage:  ../tools/gps_gen -d 3600 -x 0.003 -c 0.5 -o corpus.nmea && test_hpp corpus.nmea,
+ *          exit code is `0` when all checks pass
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "gps.hpp"
+
+static int failed;
+
+#define CHECK(expr)     do { if (!(expr)) { std::printf("%s:%d: %s\n", __FILE__, __LINE__, #expr); failed++; } } while (0)
+
+/**
+ * \brief           Build sentence with checksum and line end
+ * \param[in]       body: Sentence without `$` and checksum
+ */
+static std::string
+sentence(const std::string& body) {
+    char crc[8];
+    std::uint8_t c = 0;
+
+    for (char ch : body) {
+        c ^= static_cast<std::uint8_t>(ch);
+    }
+    std::snprintf(crc, sizeof(crc), "*%02X\r\n", c);
+    return "$" + body + crc;
+}
+
+/**
+ * \brief           Compare published values. C parser converts numbers through `float`,
+ *                  so positions differ by up to its rounding error
+ * \return          `1` when values match, `0` otherwise
+ */
+static int
+same_fix(const gps_fix_t& a, const gps_fix_t& b) {
+    auto near = [](double x, double y, double tol) { return std::fabs(x - y) <= tol * (1 + std::fabs(x)); };
+
+    return near(a.gga.latitude, b.gga.latitude, 1e-7) && near(a.gga.longitude, b.gga.longitude, 1e-7)
+        && near(a.gga.altitude, b.gga.altitude, 1e-6) && near(a.gga.geo_sep, b.gga.geo_sep, 1e-6)
+        && near(a.gga.hdop, b.gga.hdop, 1e-6) && a.gga.fix == b.gga.fix
+        && a.gga.sats_in_use == b.gga.sats_in_use && a.gga.hours == b.gga.hours
+        && a.gga.minutes == b.gga.minutes && a.gga.seconds == b.gga.seconds
+        && a.gga.timed == b.gga.timed && a.gga.dated == b.gga.dated && a.gga.epoch == b.gga.epoch
+        && near(a.rmc.speed, b.rmc.speed, 1e-6) && near(a.rmc.coarse, b.rmc.coarse, 1e-6)
+        && near(a.rmc.variation, b.rmc.variation, 1e-6) && a.rmc.is_valid == b.rmc.is_valid
+        && a.rmc.date == b.rmc.date && a.rmc.month == b.rmc.month && a.rmc.year == b.rmc.year;
+}
+
+/**
+ * \brief           Both parsers of one stream
+ */
+struct pair {
+    gps_t gh;
+    gps::parser<> cpp;
+    std::size_t lines = 0, bad = 0;
+
+    pair() { gps_init(&gh); }
+
+    /**
+     * \brief       Pass one line to both parsers and compare published values
+     */
+    void
+    line(const char* s, std::size_t len) {
+        gps_fix_t fix;
+
+        gps_process(&gh, s, len);
+        cpp.process(std::as_bytes(std::span(s, len)));
+        gps_get_fix(&gh, &fix);
+        lines++;
+        if (!same_fix(fix, cpp.out().get()) && bad++ < 5) {
+            std::printf("mismatch at line %lu\n", (unsigned long)lines);
+        }
+    }
+
+    void
+    line(const std::string& s) {
+        line(s.data(), s.size());
+    }
+};
+
+int
+main(int argc, char** argv) {
+    static pair p;
+
+    /* Date with dropped digit, too many digits or non-digits stays unknown in both */
+    p.line(sentence("GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W"));
+    p.line(sentence("GPRMC,123520,A,4807.038,N,01131.000,E,022.4,084.4,01012,003.1,W"));
+    CHECK(p.cpp.out().get().rmc.date == 0);
+    p.line(sentence("GPRMC,123521,A,4807.038,N,01131.000,E,022.4,084.4,0101260,003.1,W"));
+    p.line(sentence("GPRMC,123522,A,4807.038,N,01131.000,E,022.4,084.4,0101.6,003.1,W"));
+    p.line(sentence("GPRMC,123523,A,4807.038,N,01131.000,E,022.4,084.4,01-126,003.1,W"));
+    p.line(sentence("GPRMC,123524,A,4807.038,N,01131.000,E,022.4,084.4,01A126,003.1,W"));
+    p.line(sentence("GPRMC,123525,A,4807.038,N,01131.000,E,022.4,084.4,010126,003.1,W"));
+    CHECK(p.cpp.out().get().rmc.date == 1 && p.cpp.out().get().rmc.year == 26);
+
+    /* Time with missing or extra digits */
+    p.line(sentence("GPGGA,12352,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,"));
+    p.line(sentence("GPGGA,1235260,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,"));
+    p.line(sentence("GPGGA,123527.1234,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,"));
+    CHECK(p.bad == 0);
+
+    if (argc > 1) {
+        static pair g;
+        std::vector<char> data;
+        std::FILE* f = std::fopen(argv[1], "rb");
+        std::size_t start = 0, i;
+        char buf[65536];
+
+        CHECK(f != NULL);
+        while (f != NULL && (i = std::fread(buf, 1, sizeof(buf), f)) > 0) {
+            data.insert(data.end(), buf, buf + i);
+        }
+        if (f != NULL) {
+            std::fclose(f);
+        }
+        for (i = 0; i < data.size(); i++) {
+            if (data[i] == '\n' || i + 1 == data.size()) {
+                g.line(&data[start], i + 1 - start);
+                start = i + 1;
+            }
+        }
+        std::printf("lines: %lu, mismatches: %lu\n", (unsigned long)g.lines, (unsigned long)g.bad);
+        CHECK(g.lines > 0 && g.bad == 0);
+    }
+
+    std::printf("%s\n", failed ? "FAIL" : "OK");
+    return failed != 0;
+}
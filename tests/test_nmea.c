@@ -0,0 +1,139 @@
+/*
+ * test_nmea.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: junaidkhan
+ *
+ *  Behavior test of NMEA framing: sentences cut by next `$`, longer than
+ *  GPS_CFG_NMEA_MAX_LEN, without `*`, with invalid checksum digits, wrong checksum
+ *  or too few fields are counted and never published, whole stream or byte by byte.
+ *
+ *  Build:  cc -O2 -std=c99 -I.. -DGPS_CFG_STATS=1 test_nmea.c ../gps.c ../gps_buff.c ../gps_prof.c -lm -o test_nmea
+ *  Usage:  test_nmea, exit code is `0` when all checks pass
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "gps.h"
+
+#define GGA_OK          "GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,"
+#define RMC_OK          "GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W"
+
+static int failed;
+
+#define CHECK(expr)     do { if (!(expr)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #expr); failed++; } } while (0)
+
+/**
+ * \brief           Pass text to parser in chunks
+ * \param[in]       gh: GPS handle
+ * \param[in]       s: Text
+ * \param[in]       chunk: Number of bytes per call of \ref gps_process
+ */
+static void
+feed_raw(gps_t* gh, const char* s, size_t chunk) {
+    size_t n = strlen(s), o;
+
+    for (o = 0; o < n; o += chunk) {
+        gps_process(gh, &s[o], o + chunk <= n ? chunk : n - o);
+    }
+}
+
+/**
+ * \brief           Pass sentence with correct checksum to parser
+ * \param[in]       gh: GPS handle
+ * \param[in]       body: Sentence between `$` and `*`
+ * \param[in]       chunk: Number of bytes per call of \ref gps_process
+ */
+static void
+feed(gps_t* gh, const char* body, size_t chunk) {
+    char line[512];
+    uint8_t crc = 0;
+    const char* c;
+
+    for (c = body; *c; c++) {
+        crc ^= (uint8_t)*c;
+    }
+    snprintf(line, sizeof(line), "$%s*%02X\r\n", body, crc);
+    feed_raw(gh, line, chunk);
+}
+
+/**
+ * \brief           Check counters against expected values
+ */
+static int
+stats_are(gps_t* gh, uint32_t pub, uint32_t ign, uint32_t crc, uint32_t fmt, uint32_t len) {
+    gps_stats_t st;
+
+    return gps_get_stats(gh, &st) && st.published == pub && st.ignored == ign
+        && st.crc_errors == crc && st.format_errors == fmt && st.length_errors == len;
+}
+
+/**
+ * \brief           Run all cases with given chunk size
+ * \param[in]       chunk: Number of bytes per call of \ref gps_process
+ */
+static void
+run(size_t chunk) {
+    static gps_t gh;
+    char body[256];
+    gps_fix_t fix;
+
+    gps_init(&gh);
+    feed(&gh, GGA_OK, chunk);
+    feed(&gh, RMC_OK, chunk);
+    CHECK(stats_are(&gh, 2, 0, 0, 0, 0));
+    CHECK(gps_get_fix(&gh, &fix));
+    CHECK(fix.gga.sats_in_use == 8 && fix.rmc.date == 23);
+
+    /* Sentence type not parsed */
+    feed(&gh, "GPVTG,054.7,T,034.4,M,005.5,N,010.2,K", chunk);
+    CHECK(stats_are(&gh, 2, 1, 0, 0, 0));
+
+    /* Cut by next `$`, following sentence is still published */
+    feed_raw(&gh, "$GPGGA,123520,4807.0", chunk);
+    feed(&gh, GGA_OK, chunk);
+    CHECK(stats_are(&gh, 3, 1, 0, 1, 0));
+
+    /* Longer than GPS_CFG_NMEA_MAX_LEN */
+    snprintf(body, sizeof(body), "%s,%0*d", GGA_OK, GPS_CFG_NMEA_MAX_LEN, 0);
+    feed(&gh, body, chunk);
+    CHECK(stats_are(&gh, 3, 1, 0, 1, 1));
+
+    /* Missing `*` and checksum */
+    feed_raw(&gh, "$" GGA_OK "\r\n", chunk);
+    CHECK(stats_are(&gh, 3, 1, 0, 2, 1));
+
+    /* Checksum digits not hexadecimal, too many or too few of them */
+    feed_raw(&gh, "$" GGA_OK "*G1\r\n", chunk);
+    feed_raw(&gh, "$" GGA_OK "*123\r\n", chunk);
+    feed_raw(&gh, "$" GGA_OK "*1\r\n", chunk);
+    CHECK(stats_are(&gh, 3, 1, 0, 5, 1));
+
+    /* Wrong checksum */
+    feed_raw(&gh, "$" GGA_OK "*00\r\n", chunk);
+    CHECK(stats_are(&gh, 3, 1, 1, 5, 1));
+
+    /* Fields missing at the end, values of last fix are kept */
+    feed(&gh, "GPGGA,123521,4807.038,N,01131.000,E,1,05,0.9,545.4,M,46.9,M,", chunk);
+    feed(&gh, "GPRMC,123521,A,4807.038,N,01131.000,E,022.4,084.4,240394,003.1", chunk);
+    CHECK(stats_are(&gh, 3, 1, 1, 7, 1));
+    CHECK(gps_get_fix(&gh, &fix));
+    CHECK(fix.gga.sats_in_use == 8 && fix.rmc.date == 23);
+
+    /* Binary garbage inside sentence */
+    feed_raw(&gh, "$GPGGA,1235\x01" "19\r\n", chunk);
+    CHECK(stats_are(&gh, 3, 1, 1, 8, 1));
+
+    feed(&gh, RMC_OK, chunk);
+    CHECK(stats_are(&gh, 4, 1, 1, 8, 1));
+}
+
+int
+main(void) {
+    run(1);
+    run(4096);
+
+    printf("%s\n", failed ? "FAIL" : "OK");
+    return failed != 0;
+}
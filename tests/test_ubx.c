@@ -0,0 +1,122 @@
+/*
+ * test_ubx.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: junaidkhan
+ *
+ *  Behavior test of UBX NAV-PVT decoding: epoch of first fix carries its own
+ *  date, fix without valid time has no epoch, undated midnight is valid epoch `0`
+ *  of day `0` until date is known.
+ *
+ *  Build:  cc -O2 -std=c99 -I.. -DGPS_CFG_PROTOCOL_UBX=1 test_ubx.c ../gps.c ../gps_buff.c ../gps_prof.c -lm -o test_ubx
+ *  Usage:  test_ubx, exit code is `0` when all checks pass
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "gps.h"
+
+#define US_PER_SEC      1000000ULL
+#define EPOCH_DAY       20744ULL                /* 2026-10-18, days since 1970-01-01 */
+#define PVT_LEN         92
+
+#define VALID_DATE      0x01
+#define VALID_TIME      0x02
+
+static int failed;
+
+#define CHECK(expr)     do { if (!(expr)) { printf("%s:%d: %s\n", __FILE__, __LINE__, #expr); failed++; } } while (0)
+
+/**
+ * \brief           Pass NAV-PVT frame with given UTC time to parser
+ * \param[in]       gh: GPS handle
+ * \param[in]       year: Full year
+ * \param[in]       nano: Fraction of second in units of nanoseconds
+ * \param[in]       valid: Validity flags, `VALID_DATE` and `VALID_TIME`
+ */
+static void
+feed_pvt(gps_t* gh, uint16_t year, uint8_t month, uint8_t date,
+         uint8_t hour, uint8_t min, uint8_t sec, int32_t nano, uint8_t valid) {
+    uint8_t f[PVT_LEN + 8], ck_a = 0, ck_b = 0;
+    uint8_t* p = &f[6];
+    int32_t lat = 481173000, lon = 115167000;
+    size_t i;
+
+    memset(f, 0x00, sizeof(f));
+    f[0] = 0xB5;
+    f[1] = 0x62;
+    f[2] = 0x01;                                /* NAV */
+    f[3] = 0x07;                                /* PVT */
+    f[4] = PVT_LEN;
+    p[4] = (uint8_t)year;
+    p[5] = (uint8_t)(year >> 8);
+    p[6] = month;
+    p[7] = date;
+    p[8] = hour;
+    p[9] = min;
+    p[10] = sec;
+    p[11] = valid;
+    memcpy(&p[16], &nano, 4);                   /* Little endian host */
+    p[20] = 3;                                  /* 3D fix */
+    p[21] = 0x01;                               /* gnssFixOK */
+    p[23] = 8;
+    memcpy(&p[24], &lon, 4);
+    memcpy(&p[28], &lat, 4);
+    for (i = 2; i < PVT_LEN + 6; i++) {
+        ck_a += f[i];
+        ck_b += ck_a;
+    }
+    f[PVT_LEN + 6] = ck_a;
+    f[PVT_LEN + 7] = ck_b;
+    gps_process(gh, f, sizeof(f));
+}
+
+int
+main(void) {
+    static gps_t gh;
+    gps_fix_t fix;
+    gps_epoch_t day_us = EPOCH_DAY * 86400ULL * US_PER_SEC;
+    gps_epoch_t tod = (12ULL * 3600 + 34 * 60 + 56) * US_PER_SEC;
+
+    /* First fix already has date, its epoch is not on day `0` */
+    gps_init(&gh);
+    feed_pvt(&gh, 2026, 10, 18, 12, 34, 56, 250000000, VALID_DATE | VALID_TIME);
+    CHECK(gps_get_fix(&gh, &fix));
+    CHECK(fix.gga.fix == 1);
+    CHECK(fix.gga.timed && fix.gga.dated);
+    CHECK(fix.gga.epoch == day_us + tod + 250000);
+    CHECK(fix.rmc.date == 18 && fix.rmc.month == 10 && fix.rmc.year == 26);
+
+    /* Negative nanoseconds correct rounded-up seconds */
+    feed_pvt(&gh, 2026, 10, 18, 12, 34, 57, -100000000, VALID_DATE | VALID_TIME);
+    CHECK(gps_get_fix(&gh, &fix));
+    CHECK(fix.gga.epoch == day_us + tod + 900000);
+
+    /* Time not resolved yet, fix has no epoch */
+    feed_pvt(&gh, 2026, 10, 18, 12, 34, 58, 0, 0);
+    CHECK(gps_get_fix(&gh, &fix));
+    CHECK(!fix.gga.timed && !fix.gga.dated);
+    CHECK(fix.gga.epoch == 0);
+    CHECK(fix.rmc.date == 0);
+
+    /* Receiver without date at midnight has valid epoch `0` */
+    gps_init(&gh);
+    feed_pvt(&gh, 0, 0, 0, 0, 0, 0, 0, VALID_TIME);
+    CHECK(gps_get_fix(&gh, &fix));
+    CHECK(fix.gga.timed && !fix.gga.dated);
+    CHECK(fix.gga.epoch == 0);
+    feed_pvt(&gh, 0, 0, 0, 0, 0, 1, 0, VALID_TIME);
+    CHECK(gps_get_fix(&gh, &fix));
+    CHECK(fix.gga.timed && !fix.gga.dated);
+    CHECK(fix.gga.epoch == US_PER_SEC);
+
+    /* Date arrives later, epoch moves to it */
+    feed_pvt(&gh, 2026, 10, 18, 0, 0, 2, 0, VALID_DATE | VALID_TIME);
+    CHECK(gps_get_fix(&gh, &fix));
+    CHECK(fix.gga.dated);
+    CHECK(fix.gga.epoch == day_us + 2 * US_PER_SEC);
+
+    printf("%s\n", failed ? "FAIL" : "OK");
+    return failed != 0;
+}
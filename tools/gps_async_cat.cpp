@@ -0,0 +1,85 @@
+/*
+ * gps_async_cat.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ *
+ *  Host reader of many NMEA streams in one thread. Every serial port or pipe gets
+ *  its own coroutine printing fixes as they complete, all driven by one `epoll` reactor.
+ *
+ *  Build:  cc -O2 -I.. -c ../gps.c ../gps_buff.c ../gps_prof.c && c++ -std=c++20 -O2 -I.. gps_async_cat.cpp gps.o gps_buff.o gps_prof.o -o gps_async_cat
+ *  Usage:  gps_async_cat [-q] <port|fifo|-> ...
+ *          -q prints only number of fixes per stream, for example when replaying:
+ *          gps_async_cat -q <(cat a.nmea) <(cat b.nmea)
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "gps_async.hpp"
+
+using source_t = gps::async::source<>;
+
+/**
+ * \brief           Print fixes of one stream until it is closed
+ */
+static gps::async::task
+print_fixes(source_t& src, const char* name, bool quiet, unsigned long& fixes) {
+    while (auto fix = co_await src.next()) {
+        fixes++;
+        if (!quiet) {
+            std::printf("%s %02u:%02u:%02u %.7f %.7f %.1f fix %u sats %u\n", name,
+                (unsigned)fix->gga.hours, (unsigned)fix->gga.minutes, (unsigned)fix->gga.seconds,
+                fix->gga.latitude, fix->gga.longitude, (double)fix->gga.altitude,
+                (unsigned)fix->gga.fix, (unsigned)fix->gga.sats_in_use);
+        }
+    }
+    if (src.error() != 0) {
+        std::fprintf(stderr, "%s: %s\n", name, std::strerror(src.error()));
+    }
+}
+
+int
+main(int argc, char** argv) {
+    std::vector<std::unique_ptr<source_t>> sources;
+    std::vector<unsigned long> fixes;
+    std::vector<int> fds;
+    gps::async::reactor r;
+    bool quiet = false;
+    int i, first = 1;
+
+    if (argc > 1 && !std::strcmp(argv[1], "-q")) {
+        quiet = true;
+        first = 2;
+    }
+    if (argc <= first || !r.valid()) {
+        std::fprintf(stderr, "usage: %s [-q] <port|fifo|-> ...\n", argv[0]);
+        return 1;
+    }
+    gps_prof_init();
+    fixes.resize(argc - first);                 /* Counters must not move while coroutines run */
+    for (i = first; i < argc; i++) {
+        int fd = std::strcmp(argv[i], "-") ? open(argv[i], O_RDONLY | O_NOCTTY | O_CLOEXEC) : 0;
+        if (fd < 0) {
+            std::perror(argv[i]);
+            return 1;
+        }
+        fds.push_back(fd);
+        sources.push_back(std::make_unique<source_t>(r, fd));
+        print_fixes(*sources.back(), argv[i], quiet, fixes[i - first]);
+    }
+    r.run();
+
+    for (i = first; i < argc; i++) {
+        std::printf("%s: %lu fixes\n", argv[i], fixes[i - first]);
+        if (fds[i - first] != 0) {
+            close(fds[i - first]);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,174 @@
+/*
+ * gps_bench.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ *
+ *  Host benchmark of receive path. Replays recorded NMEA stream through
+ *  GPS ring buffer and parser, then prints throughput, parser counters and
+ *  profiling report. With `corrupt` rate, every byte of stream is dropped or
+ *  replaced by random byte with that probability before replay.
+ *
+ *  Build:  cc -O2 -I.. -DGPS_CFG_PROF=1 -DGPS_CFG_STATS=1 gps_bench.c ../gps.c ../gps_buff.c ../gps_prof.c -lm -o gps_bench
+ *  Usage:  gps_bench <file.nmea> [repeat] [chunk] [corrupt]
+ */
+
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE     199309L             /* clock_gettime */
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "gps.h"
+#include "gps_buff.h"
+#include "gps_prof.h"
+
+#define BENCH_BUFF_SIZE     1024
+
+static gps_t hgps;
+static gps_buff_t hgps_buff;
+static uint8_t hgps_buff_data[BENCH_BUFF_SIZE];
+
+/**
+ * \brief           Get monotonic time in units of seconds
+ */
+static double
+now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * \brief           Print report line to standard output
+ */
+static void
+print_line(const char* line, void* arg) {
+    (void)arg;
+    printf("%s\n", line);
+}
+
+/**
+ * \brief           Read whole file to memory
+ * \param[in]       path: Path to file, `-` for standard input
+ * \param[out]      len: Number of bytes read
+ * \return          Pointer to allocated data, `NULL` on failure
+ */
+static uint8_t*
+read_file(const char* path, size_t* len) {
+    FILE* f = strcmp(path, "-") ? fopen(path, "rb") : stdin;
+    uint8_t* data = NULL;
+    size_t cap = 0, n;
+
+    if (f == NULL) {
+        return NULL;
+    }
+    *len = 0;
+    do {
+        if (*len == cap) {
+            cap = cap ? 2 * cap : 65536;
+            data = realloc(data, cap);
+            if (data == NULL) {
+                break;
+            }
+        }
+        n = fread(&data[*len], 1, cap - *len, f);
+        *len += n;
+    } while (n > 0);
+    if (f != stdin) {
+        fclose(f);
+    }
+    return data;
+}
+
+/**
+ * \brief           Corrupt data in place, deterministic for given length and rate
+ * \param[in]       rate: Probability of each byte to be dropped or replaced
+ * \return          New length of data
+ */
+static size_t
+corrupt(uint8_t* data, size_t len, double rate) {
+    size_t i, n = 0;
+
+    srand(1);
+    for (i = 0; i < len; i++) {
+        if ((double)rand() / ((double)RAND_MAX + 1) >= rate) {
+            data[n++] = data[i];
+        } else if (rand() & 1) {                /* Replace, otherwise drop */
+            data[n++] = (uint8_t)rand();
+        }
+    }
+    return n;
+}
+
+int
+main(int argc, char** argv) {
+    uint8_t* data, chunk[BENCH_BUFF_SIZE];
+    size_t len, off, n, repeat = 100, chunk_len = 64, r;
+    gps_fix_t fix;
+    gps_stats_t st;
+    double sec, rate = 0;
+    unsigned long rejected;
+
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <file.nmea> [repeat] [chunk] [corrupt]\n", argv[0]);
+        return 1;
+    }
+    if (argc > 2) {
+        repeat = strtoul(argv[2], NULL, 0);
+    }
+    if (argc > 3) {
+        chunk_len = strtoul(argv[3], NULL, 0);
+        if (chunk_len == 0 || chunk_len >= sizeof(chunk)) {
+            chunk_len = sizeof(chunk) - 1;
+        }
+    }
+    if (argc > 4) {
+        rate = atof(argv[4]);
+    }
+    data = read_file(argv[1], &len);
+    if (data == NULL || len == 0) {
+        fprintf(stderr, "cannot read %s\n", argv[1]);
+        return 1;
+    }
+    if (rate > 0) {
+        len = corrupt(data, len, rate);
+    }
+
+    gps_prof_init();
+    gps_init(&hgps);
+    buff_init(&hgps_buff, hgps_buff_data, sizeof(hgps_buff_data));
+
+    /* Writer and reader alternate on same thread, like interrupt and main loop */
+    sec = now_sec();
+    for (r = 0; r < repeat; r++) {
+        for (off = 0; off < len; off += n) {
+            size_t rd;
+
+            n = buff_write(&hgps_buff, &data[off], chunk_len < len - off ? chunk_len : len - off);
+            while ((rd = buff_read(&hgps_buff, chunk, sizeof(chunk))) > 0) {
+                gps_process(&hgps, chunk, rd);
+            }
+        }
+    }
+    sec = now_sec() - sec;
+
+    printf("bytes: %lu, time: %.3f s, throughput: %.2f MB/s\n",
+        (unsigned long)(len * repeat), sec, (double)(len * repeat) / sec / 1e6);
+    gps_get_fix(&hgps, &fix);
+    printf("last fix: lat %.6f lon %.6f fix %u\n", fix.gga.latitude, fix.gga.longitude, (unsigned)fix.gga.fix);
+    if (gps_get_stats(&hgps, &st)) {
+        rejected = (unsigned long)st.crc_errors + st.format_errors + st.length_errors;
+        printf("published: %lu, ignored: %lu, rejected: %lu (crc %lu, format %lu, length %lu), rejection rate: %.2f %%\n",
+            (unsigned long)st.published, (unsigned long)st.ignored, rejected, (unsigned long)st.crc_errors,
+            (unsigned long)st.format_errors, (unsigned long)st.length_errors,
+            100.0 * (double)rejected / (double)(rejected + st.published + st.ignored + (rejected + st.published + st.ignored == 0)));
+    }
+    gps_prof_report(print_line, NULL);
+
+    free(data);
+    return 0;
+}
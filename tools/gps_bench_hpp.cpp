@@ -0,0 +1,149 @@
+/*
+ * gps_bench_hpp.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ *
+ *  Host benchmark of C++ parser against C parser. Checks both publish the same
+ *  values for every line of recorded NMEA stream, then replays stream through
+ *  GPS ring buffer like gps_bench and prints throughput of each path.
+ *
+ *  Build:  cc -O2 -I.. -c ../gps.c ../gps_buff.c ../gps_prof.c && c++ -std=c++20 -O2 -I.. gps_bench_hpp.cpp gps.o gps_buff.o gps_prof.o -o gps_bench_hpp
+ *  Usage:  gps_bench_hpp <file.nmea> [repeat] [chunk]
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include "gps.hpp"
+
+#define BENCH_BUFF_SIZE     1024
+
+static gps_t hgps;
+static gps_buff_t hgps_buff;
+static uint8_t hgps_buff_data[BENCH_BUFF_SIZE];
+
+/**
+ * \brief           Get monotonic time in units of seconds
+ */
+static double
+now_sec() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * \brief           Compare published values. C parser converts numbers through `float`,
+ *                  so positions differ by up to its rounding error
+ * \return          `1` when values match, `0` otherwise
+ */
+static int
+same_fix(const gps_fix_t& a, const gps_fix_t& b) {
+    auto near = [](double x, double y, double tol) { return std::fabs(x - y) <= tol * (1 + std::fabs(x)); };
+
+    return near(a.gga.latitude, b.gga.latitude, 1e-7) && near(a.gga.longitude, b.gga.longitude, 1e-7)
+        && near(a.gga.altitude, b.gga.altitude, 1e-6) && near(a.gga.geo_sep, b.gga.geo_sep, 1e-6)
+        && near(a.gga.hdop, b.gga.hdop, 1e-6) && a.gga.fix == b.gga.fix
+        && a.gga.sats_in_use == b.gga.sats_in_use && a.gga.hours == b.gga.hours
+        && a.gga.minutes == b.gga.minutes && a.gga.seconds == b.gga.seconds
+        && a.gga.timed == b.gga.timed && a.gga.dated == b.gga.dated && a.gga.epoch == b.gga.epoch
+        && near(a.rmc.speed, b.rmc.speed, 1e-6) && near(a.rmc.coarse, b.rmc.coarse, 1e-6)
+        && near(a.rmc.variation, b.rmc.variation, 1e-6) && a.rmc.is_valid == b.rmc.is_valid
+        && a.rmc.date == b.rmc.date && a.rmc.month == b.rmc.month && a.rmc.year == b.rmc.year;
+}
+
+/**
+ * \brief           Replay data through ring buffer, writer and reader alternate on same thread
+ * \param[in]       process: Function processing all data waiting in buffer
+ * \return          Time in seconds
+ */
+template<class F>
+static double
+replay(const std::vector<std::byte>& data, size_t repeat, size_t chunk_len, F&& process) {
+    size_t off, n, r;
+    double sec;
+
+    sec = now_sec();
+    for (r = 0; r < repeat; r++) {
+        for (off = 0; off < data.size(); off += n) {
+            n = buff_write(&hgps_buff, &data[off], chunk_len < data.size() - off ? chunk_len : data.size() - off);
+            process();
+        }
+    }
+    return now_sec() - sec;
+}
+
+int
+main(int argc, char** argv) {
+    std::vector<std::byte> data;
+    size_t repeat = 100, chunk_len = 64, len, lines = 0, bad = 0, recs = 0, start, i;
+    gps::parser<> cpp;
+    gps::parser<gps::sentences<gps::sentence::gga>, gps::fields::position | gps::fields::time> cpp_pos;
+    gps_fix_t fix;
+    double sec_c, sec_cpp, sec_pos;
+    std::FILE* f;
+
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <file.nmea> [repeat] [chunk]\n", argv[0]);
+        return 1;
+    }
+    if (argc > 2) {
+        repeat = std::strtoul(argv[2], NULL, 0);
+    }
+    if (argc > 3) {
+        chunk_len = std::strtoul(argv[3], NULL, 0);
+        if (chunk_len == 0 || chunk_len >= BENCH_BUFF_SIZE) {
+            chunk_len = BENCH_BUFF_SIZE - 1;
+        }
+    }
+    if ((f = std::strcmp(argv[1], "-") ? std::fopen(argv[1], "rb") : stdin) == NULL) {
+        std::perror(argv[1]);
+        return 1;
+    }
+    do {
+        len = data.size();
+        data.resize(len + 65536);
+        data.resize(len + std::fread(&data[len], 1, 65536, f));
+    } while (data.size() > len);
+    if (f != stdin) {
+        std::fclose(f);
+    }
+    if (data.empty()) {
+        std::fprintf(stderr, "cannot read %s\n", argv[1]);
+        return 1;
+    }
+
+    /* Check C++ parser publishes same values as C parser after every line */
+    gps_init(&hgps);
+    for (start = 0, i = 0; i < data.size(); i++) {
+        if (data[i] == std::byte{ '\n' } || i + 1 == data.size()) {
+            std::span<const std::byte> line(&data[start], i + 1 - start);
+            gps_process(&hgps, line.data(), line.size());
+            recs += cpp.process(line);
+            gps_get_fix(&hgps, &fix);
+            if (!same_fix(fix, cpp.out().get()) && bad++ < 5) {
+                std::printf("mismatch at line %lu\n", (unsigned long)lines + 1);
+            }
+            lines++;
+            start = i + 1;
+        }
+    }
+    std::printf("lines: %lu, records: %lu, mismatches: %lu\n", (unsigned long)lines,
+        (unsigned long)recs, (unsigned long)bad);
+
+    buff_init(&hgps_buff, hgps_buff_data, sizeof(hgps_buff_data));
+    gps_init(&hgps);
+    sec_c = replay(data, repeat, chunk_len, [] { gps_process_buff(&hgps, &hgps_buff); });
+    sec_cpp = replay(data, repeat, chunk_len, [&] { cpp.process(hgps_buff); });
+    sec_pos = replay(data, repeat, chunk_len, [&] { cpp_pos.process(hgps_buff); });
+
+    len = data.size() * repeat;
+    std::printf("C parser:              %8.2f MB/s\n", (double)len / sec_c / 1e6);
+    std::printf("C++ parser:            %8.2f MB/s, %.2fx\n", (double)len / sec_cpp / 1e6, sec_c / sec_cpp);
+    std::printf("C++ GGA position only: %8.2f MB/s, %.2fx\n", (double)len / sec_pos / 1e6, sec_c / sec_pos);
+    return bad != 0;
+}
@@ -0,0 +1,352 @@
+/*
+ * gps_daemon.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ *
+ *  Local NMEA daemon. Reads receiver stream from serial device, pty, file or
+ *  standard input into one broadcast ring (see gps_bcast.h). Parser reads the ring
+ *  with gps_process and publishes fix after every accepted statement (GSV also
+ *  republishes current fix) to
+ *  - shared memory ring (see gps_shm.h), read by consumers without system calls
+ *  - UNIX stream socket, one text line per fix to every connected client
+ *  With `-l`, raw stream is also logged to file from the same ring, without second copy.
+ *
+ *  Build:  cc -O2 -std=c11 -I.. -DGPS_CFG_STATS=1 -DGPS_CFG_STATEMENT_GPGSV=1 -DGPS_CFG_PROTOCOL_UBX=1 gps_daemon.c ../gps.c ../gps_buff.c ../gps_prof.c ../gps_bcast.c -lm -lrt -o gps_daemon
+ *  Usage:  gps_daemon [-b baud] [-m /shm_name] [-s socket_path] [-l raw_log] <device|file|->
+ */
+
+#define _GNU_SOURCE                             /* cfmakeraw, shm_open, accept4 */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "gps.h"
+#include "gps_bcast.h"
+#include "gps_prof.h"
+#include "gps_shm.h"
+
+#if !GPS_CFG_STATS
+#error "gps_daemon detects new fixes by published counter, GPS_CFG_STATS must be enabled"
+#endif
+
+#define DAEMON_MAX_CLIENTS      16
+#define DAEMON_BUFF_SIZE        4096
+
+static gps_t hgps;
+static gps_bcast_t hraw;                        /* Raw stream, read by parser and logger */
+static uint8_t hraw_data[DAEMON_BUFF_SIZE];
+
+static volatile sig_atomic_t running = 1;
+
+/**
+ * \brief           Stop main loop on signal
+ */
+static void
+on_signal(int sig) {
+    (void)sig;
+    running = 0;
+}
+
+/**
+ * \brief           Convert baudrate to termios speed
+ */
+static speed_t
+baud_to_speed(long baud) {
+    switch (baud) {
+        case 4800: return B4800;
+        case 9600: return B9600;
+        case 19200: return B19200;
+        case 38400: return B38400;
+        case 57600: return B57600;
+        case 115200: return B115200;
+        case 230400: return B230400;
+        default: return B9600;
+    }
+}
+
+/**
+ * \brief           Open input stream, configure serial line when input is terminal
+ * \param[in]       path: Path to device or file, `-` for standard input
+ * \param[in]       baud: Baudrate for serial devices
+ * \return          File descriptor, `-1` on failure
+ */
+static int
+open_input(const char* path, long baud) {
+    struct termios tio;
+    int fd;
+
+    fd = strcmp(path, "-") ? open(path, O_RDONLY | O_NOCTTY) : STDIN_FILENO;
+    if (fd >= 0 && isatty(fd) && tcgetattr(fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        cfsetispeed(&tio, baud_to_speed(baud));
+        cfsetospeed(&tio, baud_to_speed(baud));
+        tio.c_cc[VMIN] = 1;
+        tio.c_cc[VTIME] = 0;
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    return fd;
+}
+
+/**
+ * \brief           Create and map shared memory ring
+ * \param[in]       name: Shared memory object name, for example `/gps0`
+ * \return          Mapped memory, `NULL` on failure
+ */
+static gps_shm_t*
+open_shm(const char* name) {
+    gps_shm_t* shm;
+    int fd;
+
+    fd = shm_open(name, O_CREAT | O_RDWR, 0644);
+    if (fd < 0) {
+        return NULL;
+    }
+    if (ftruncate(fd, sizeof(*shm)) != 0) {
+        close(fd);
+        return NULL;
+    }
+    shm = mmap(NULL, sizeof(*shm), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (shm == MAP_FAILED) {
+        return NULL;
+    }
+    memset(shm, 0x00, sizeof(*shm));
+    shm->fix_size = sizeof(gps_fix_t);
+    atomic_thread_fence(memory_order_release);
+    shm->magic = GPS_SHM_MAGIC;
+    return shm;
+}
+
+/**
+ * \brief           Create listening UNIX socket
+ * \param[in]       path: Socket path
+ * \return          Socket descriptor, `-1` on failure
+ */
+static int
+open_socket(const char* path) {
+    struct sockaddr_un addr;
+    int fd;
+
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    memset(&addr, 0x00, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    unlink(path);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, DAEMON_MAX_CLIENTS) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * \brief           Get host monotonic time
+ * \return          Time in units of nanoseconds
+ */
+static uint64_t
+now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * \brief           Send fix as text line to all clients, drop clients which cannot keep up
+ */
+static void
+send_clients(int* clients, const gps_shm_fix_t* f) {
+    char line[256];
+    int len, i;
+
+    len = snprintf(line, sizeof(line), "FIX,%llu,%.8f,%.8f,%.2f,%u,%u,%02u:%02u:%02u,%u,%02u%02u%02u,%.2f,%.2f\n",
+        (unsigned long long)f->seq, f->fix.gga.latitude, f->fix.gga.longitude, (double)f->fix.gga.altitude,
+        (unsigned)f->fix.gga.fix, (unsigned)f->fix.gga.sats_in_use, (unsigned)f->fix.gga.hours,
+        (unsigned)f->fix.gga.minutes, (unsigned)f->fix.gga.seconds, (unsigned)f->fix.rmc.is_valid,
+        (unsigned)f->fix.rmc.date, (unsigned)f->fix.rmc.month, (unsigned)f->fix.rmc.year,
+        (double)f->fix.rmc.speed, (double)f->fix.rmc.coarse);
+    for (i = 0; i < DAEMON_MAX_CLIENTS; i++) {
+        if (clients[i] >= 0 && send(clients[i], line, (size_t)len, MSG_NOSIGNAL | MSG_DONTWAIT) != len) {
+            close(clients[i]);
+            clients[i] = -1;
+        }
+    }
+}
+
+/**
+ * \brief           Parse all data waiting for parser reader, publish fix after every accepted statement
+ * \param[in]       id: Parser reader ID
+ * \param[in]       ts: Receive time of data
+ * \param[in]       shm: Shared memory ring
+ * \param[in]       clients: Connected socket clients
+ * \param[in,out]   published: Published counter of last published fix
+ */
+static void
+parse_raw(uint8_t id, gps_tick_t ts, gps_shm_t* shm, int* clients, uint32_t* published) {
+    const uint8_t *p, *eol;
+    gps_shm_fix_t out;
+    gps_stats_t stats;
+    size_t len;
+
+    while ((len = bcast_get_linear_block(&hraw, id, &p)) > 0) {
+        /* Process line by line, to publish every statement even when many come in one read */
+        eol = memchr(p, '\n', len);
+        len = eol != NULL ? (size_t)(eol - p) + 1 : len;
+        gps_set_rx_time(&hgps, ts);
+        gps_process(&hgps, p, len);
+        bcast_skip(&hraw, id, len);
+
+        /* Publish when statement was accepted, receive times may repeat within one read */
+        gps_get_stats(&hgps, &stats);
+        if (stats.published != *published) {
+            *published = stats.published;
+            gps_get_fix(&hgps, &out.fix);
+            out.rx_ns = now_ns();
+            gps_shm_publish(shm, &out);
+            send_clients(clients, &out);
+        }
+    }
+}
+
+/**
+ * \brief           Write all data waiting for logger reader to log file
+ * \param[in]       id: Logger reader ID
+ * \param[in]       fd: Log file descriptor
+ * \return          `1` on success, `0` on write error
+ */
+static uint8_t
+log_raw(uint8_t id, int fd) {
+    const uint8_t* p;
+    size_t len;
+    ssize_t n;
+
+    while ((len = bcast_get_linear_block(&hraw, id, &p)) > 0) {
+        n = write(fd, p, len);
+        if (n <= 0) {
+            return 0;
+        }
+        bcast_skip(&hraw, id, (size_t)n);
+    }
+    return 1;
+}
+
+int
+main(int argc, char** argv) {
+    const char* shm_name = "/gps0";
+    const char* sock_path = "/tmp/gps0.sock";
+    const char* log_path = NULL;
+    int clients[DAEMON_MAX_CLIENTS];
+    struct pollfd pfd[2];
+    uint32_t published = 0;
+    gps_shm_t* shm;
+    uint8_t data[512], parser_id, log_id = 0;
+    long baud = 9600;
+    ssize_t n;
+    int opt, in, srv, logfd = -1, i, c;
+
+    while ((opt = getopt(argc, argv, "b:m:s:l:")) != -1) {
+        switch (opt) {
+            case 'b': baud = strtol(optarg, NULL, 0); break;
+            case 'm': shm_name = optarg; break;
+            case 's': sock_path = optarg; break;
+            case 'l': log_path = optarg; break;
+            default:
+                fprintf(stderr, "usage: %s [-b baud] [-m /shm_name] [-s socket_path] [-l raw_log] <device|file|->\n", argv[0]);
+                return 1;
+        }
+    }
+    if (optind >= argc) {
+        fprintf(stderr, "missing input\n");
+        return 1;
+    }
+
+    in = open_input(argv[optind], baud);
+    shm = open_shm(shm_name);
+    srv = open_socket(sock_path);
+    if (log_path != NULL) {
+        logfd = open(log_path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    }
+    if (in < 0 || shm == NULL || srv < 0 || (log_path != NULL && logfd < 0)) {
+        fprintf(stderr, "cannot open %s: %s\n", in < 0 ? argv[optind] : shm == NULL ? shm_name : srv < 0 ? sock_path : log_path, strerror(errno));
+        return 1;
+    }
+    for (i = 0; i < DAEMON_MAX_CLIENTS; i++) {
+        clients[i] = -1;
+    }
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    gps_init(&hgps);
+    bcast_init(&hraw, hraw_data, sizeof(hraw_data));
+    bcast_reader_add(&hraw, &parser_id);
+    if (logfd >= 0) {
+        bcast_reader_add(&hraw, &log_id);
+    }
+
+    pfd[0].fd = in;
+    pfd[0].events = POLLIN;
+    pfd[1].fd = srv;
+    pfd[1].events = POLLIN;
+    while (running) {
+        if (poll(pfd, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (pfd[1].revents & POLLIN) {          /* New consumer */
+            c = accept4(srv, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            for (i = 0; c >= 0 && i < DAEMON_MAX_CLIENTS && clients[i] >= 0; i++) {}
+            if (c >= 0 && i < DAEMON_MAX_CLIENTS) {
+                clients[i] = c;
+            } else if (c >= 0) {
+                close(c);
+            }
+        }
+        if (pfd[0].revents & (POLLIN | POLLHUP)) {
+            n = read(in, data, sizeof(data));
+            if (n <= 0) {                       /* End of file or device gone */
+                break;
+            }
+            bcast_write(&hraw, data, (size_t)n);    /* Stream is stored once, parser and logger read it from ring */
+            parse_raw(parser_id, gps_prof_now(), shm, clients, &published);
+            if (logfd >= 0 && !log_raw(log_id, logfd)) {
+                fprintf(stderr, "cannot write %s: %s\n", log_path, strerror(errno));
+                bcast_reader_remove(&hraw, log_id);
+                close(logfd);
+                logfd = -1;
+            }
+        }
+    }
+
+    fprintf(stderr, "parser: lag %zu, overruns %lu\n", hraw.readers[parser_id].max_lag, (unsigned long)hraw.readers[parser_id].overruns);
+    if (logfd >= 0) {
+        fprintf(stderr, "logger: lag %zu, overruns %lu\n", hraw.readers[log_id].max_lag, (unsigned long)hraw.readers[log_id].overruns);
+        close(logfd);
+    }
+
+    for (i = 0; i < DAEMON_MAX_CLIENTS; i++) {
+        if (clients[i] >= 0) {
+            close(clients[i]);
+        }
+    }
+    close(srv);
+    unlink(sock_path);
+    munmap(shm, sizeof(*shm));
+    shm_unlink(shm_name);
+    return 0;
+}
@@ -0,0 +1,191 @@
+/*
+ * gps_fence_check.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ *
+ *  Host range-safety check. Replays recorded NMEA stream, checks every new fix
+ *  against geofence and prints violations, or every fix with `-a`.
+ *
+ *  Fence file, one zone per line, `#` starts comment:
+ *      ref <lat> <lon>                             reference of local frame, default first point
+ *      keepin|keepout poly <lat> <lon> ...         polygon, at least 3 vertices
+ *      keepin|keepout circle <lat> <lon> <radius>  circle, radius in meters
+ *
+ *  Build:  cc -O2 -I.. gps_fence_check.c ../gps.c ../gps_buff.c ../gps_prof.c ../gps_fence.c -lm -o gps_fence_check
+ *  Usage:  gps_fence_check [-a] <fence.txt> <file.nmea>
+ */
+
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE     200809L             /* clock_gettime, getopt */
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "gps.h"
+#include "gps_fence.h"
+
+#define MAX_VERTICES        64
+
+static gps_t hgps;
+static gps_fence_t hfence;
+
+/**
+ * \brief           Get monotonic time in units of seconds
+ */
+static double
+now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * \brief           Load fence file
+ * \return          `1` on success, `0` otherwise
+ */
+static int
+load_fence(const char* path) {
+    gps_float_t lat[MAX_VERTICES], lon[MAX_VERTICES];
+    char line[1024], kind[16], type[16], *s, *end;
+    double a, b, r = 0;
+    int n, init = 0, lineno = 0, has_r, ok;
+    FILE* f = fopen(path, "r");
+
+    if (f == NULL) {
+        perror(path);
+        return 0;
+    }
+    while (fgets(line, sizeof(line), f) != NULL) {
+        lineno++;
+        if ((s = strchr(line, '#')) != NULL) {
+            *s = 0;
+        }
+        if (sscanf(line, "%15s", kind) != 1) {
+            continue;                           /* Empty line */
+        }
+        if (!strcmp(kind, "ref")) {
+            if (init || sscanf(line, "%*s %lf %lf", &a, &b) != 2) {
+                break;
+            }
+            gps_fence_init(&hfence, a, b);
+            init = 1;
+            continue;
+        }
+        if (sscanf(line, "%15s %15s%n", kind, type, &n) != 2
+            || (strcmp(kind, "keepin") && strcmp(kind, "keepout"))) {
+            break;
+        }
+        s = line + n;
+        has_r = 0;
+        for (n = 0; n < MAX_VERTICES; n++) {    /* Pairs of coordinates, then optional radius */
+            a = strtod(s, &end);
+            if (end == s) {
+                break;
+            }
+            b = strtod(s = end, &end);
+            if (end == s) {
+                r = a;                          /* Single number left is radius */
+                has_r = 1;
+                break;
+            }
+            s = end;
+            lat[n] = a;
+            lon[n] = b;
+        }
+        if (!init && n > 0) {                   /* Reference is first point of file */
+            gps_fence_init(&hfence, lat[0], lon[0]);
+            init = 1;
+        }
+        if (!strcmp(type, "poly")) {
+            ok = !has_r && n < MAX_VERTICES && gps_fence_add_polygon(&hfence,
+                    strcmp(kind, "keepin") ? GPS_FENCE_KEEP_OUT : GPS_FENCE_KEEP_IN, lat, lon, (size_t)n, NULL);
+        } else if (!strcmp(type, "circle")) {
+            ok = has_r && n == 1 && gps_fence_add_circle(&hfence,
+                    strcmp(kind, "keepin") ? GPS_FENCE_KEEP_OUT : GPS_FENCE_KEEP_IN, lat[0], lon[0], r, NULL);
+        } else {
+            ok = 0;
+        }
+        if (!ok) {
+            break;
+        }
+    }
+    if (!feof(f)) {
+        fprintf(stderr, "%s:%d: invalid zone or too many zones\n", path, lineno);
+        fclose(f);
+        return 0;
+    }
+    fclose(f);
+    if (!init || !gps_fence_compile(&hfence)) {
+        fprintf(stderr, "%s: no zones or index does not fit GPS_CFG_FENCE_POOL\n", path);
+        return 0;
+    }
+    return 1;
+}
+
+int
+main(int argc, char** argv) {
+    gps_fence_result_t res;
+    gps_fix_t fix;
+    char line[256];
+    gps_epoch_t last_key = GPS_EPOCH_NONE;
+    unsigned long fixes = 0, violations = 0;
+    double t0, t_check = 0;
+    int opt, all = 0;
+    FILE* f;
+
+    while ((opt = getopt(argc, argv, "a")) != -1) {
+        if (opt == 'a') {
+            all = 1;
+        } else {
+            optind = argc + 1;
+            break;
+        }
+    }
+    if (argc - optind != 2) {
+        fprintf(stderr, "usage: %s [-a] <fence.txt> <file.nmea>\n", argv[0]);
+        return 1;
+    }
+    if (!load_fence(argv[optind])) {
+        return 1;
+    }
+    if ((f = strcmp(argv[optind + 1], "-") ? fopen(argv[optind + 1], "rb") : stdin) == NULL) {
+        perror(argv[optind + 1]);
+        return 1;
+    }
+    printf("%u zones, %u edges, at most %u edges checked per fix\n",
+        (unsigned)hfence.zone_count, (unsigned)hfence.edge_count, (unsigned)hfence.max_refs);
+
+    gps_init(&hgps);
+    while (fgets(line, sizeof(line), f) != NULL) {
+        gps_process(&hgps, line, strlen(line));
+        gps_get_fix(&hgps, &fix);
+        if (!fix.gga.fix || !fix.gga.timed || fix.gga.epoch == last_key) {
+            continue;
+        }
+        last_key = fix.gga.epoch;
+
+        t0 = now_sec();
+        gps_fence_check(&hfence, fix.gga.latitude, fix.gga.longitude, &res);
+        t_check += now_sec() - t0;
+        fixes++;
+        violations += res.violated != 0;
+        if (all || res.violated) {
+            printf("%02u:%02u:%02u %.7f %.7f inside=%08lX violated=%08lX dist=%.1f zone=%u%s\n",
+                (unsigned)fix.gga.hours, (unsigned)fix.gga.minutes, (unsigned)fix.gga.seconds,
+                (double)fix.gga.latitude, (double)fix.gga.longitude,
+                (unsigned long)res.inside, (unsigned long)res.violated, (double)res.dist,
+                (unsigned)res.nearest, res.violated ? " VIOLATION" : "");
+        }
+    }
+    if (f != stdin) {
+        fclose(f);
+    }
+    printf("%lu fixes, %lu in violation, %.0f ns per check\n", fixes, violations,
+        fixes ? t_check / (double)fixes * 1e9 : 0.0);
+    return violations != 0;
+}
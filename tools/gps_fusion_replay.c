@@ -0,0 +1,154 @@
+/*
+ * gps_fusion_replay.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ *
+ *  Host test of fusion stage. Replays two recorded NMEA streams merged by UTC time
+ *  of their sentences, as if both receivers were connected at once, and prints
+ *  one line per fused epoch.
+ *
+ *  Build:  cc -O2 -I.. gps_fusion_replay.c ../gps.c ../gps_buff.c ../gps_prof.c ../gps_fusion.c -lm -o gps_fusion_replay
+ *  Usage:  gps_fusion_replay [-s max_sep] [-a max_alt] [-n] <a.nmea> <b.nmea>
+ */
+
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE     200809L             /* getopt */
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "gps.h"
+#include "gps_fusion.h"
+
+#define RX_COUNT            2
+
+/**
+ * \brief           Recorded stream of one receiver
+ */
+typedef struct {
+    FILE* f;                                    /*!< Open file, `NULL` at end of stream */
+    char line[256];                             /*!< Next line to process */
+    double t;                                   /*!< UTC time of next line in seconds, continuous over midnight */
+} stream_t;
+
+static gps_t hgps[RX_COUNT];
+static gps_fusion_t hfusion;
+static stream_t streams[RX_COUNT];
+
+/**
+ * \brief           Read next line of stream and get its UTC time.
+ *                  Lines without time keep time of previous line
+ * \param[in]       s: Stream
+ * \return          `1` on success, `0` at end of stream
+ */
+static int
+stream_next(stream_t* s) {
+    const char* c;
+    double t;
+
+    if (s->f == NULL) {
+        return 0;
+    }
+    if (fgets(s->line, sizeof(s->line), s->f) == NULL) {
+        fclose(s->f);
+        s->f = NULL;
+        return 0;
+    }
+    c = strchr(s->line, ',');                   /* Time is first term of GGA, RMC, ... */
+    if (c != NULL && strncmp(c - 3, "GSV", 3) && strncmp(c - 3, "GSA", 3)
+        && c[1] >= '0' && c[1] <= '9' && strlen(c) > 7) {
+        t = ((c[1] - '0') * 10 + (c[2] - '0')) * 3600.0
+            + ((c[3] - '0') * 10 + (c[4] - '0')) * 60.0 + atof(c + 5);
+        t += 86400.0 * (double)(long)(s->t / 86400.0);
+        if (t < s->t - 43200.0) {               /* Past midnight */
+            t += 86400.0;
+        }
+        s->t = t;
+    }
+    return 1;
+}
+
+/**
+ * \brief           Print fused epoch
+ */
+static void
+print_out(const gps_fusion_out_t* o) {
+    const gps_gga_t* g = &o->fix.gga;
+    printf("%02u:%02u:%02u src=%u used=%02X fix=%u sats=%2u hdop=%5.2f lat=%.7f lon=%.7f alt=%.2f sep=%.2f dalt=%.2f%s%s\n",
+        (unsigned)g->hours, (unsigned)g->minutes, (unsigned)g->seconds,
+        (unsigned)o->source, (unsigned)o->used, (unsigned)g->fix, (unsigned)g->sats_in_use,
+        (double)g->hdop, (double)g->latitude, (double)g->longitude, (double)g->altitude,
+        (double)o->sep, (double)o->alt_diff,
+        o->blended ? " blended" : "", o->disagree ? " DISAGREE" : "");
+}
+
+int
+main(int argc, char** argv) {
+    gps_t* rx[RX_COUNT];
+    gps_fusion_out_t out;
+    double max_sep = GPS_CFG_FUSION_MAX_SEP, max_alt = GPS_CFG_FUSION_MAX_ALT;
+    unsigned long epochs = 0, disagree = 0, blended = 0;
+    int opt, i, next, blend = 1;
+
+    while ((opt = getopt(argc, argv, "s:a:n")) != -1) {
+        switch (opt) {
+            case 's': max_sep = atof(optarg); break;
+            case 'a': max_alt = atof(optarg); break;
+            case 'n': blend = 0; break;
+            default:
+                fprintf(stderr, "usage: %s [-s max_sep] [-a max_alt] [-n] <a.nmea> <b.nmea>\n", argv[0]);
+                return 1;
+        }
+    }
+    if (argc - optind != RX_COUNT) {
+        fprintf(stderr, "usage: %s [-s max_sep] [-a max_alt] [-n] <a.nmea> <b.nmea>\n", argv[0]);
+        return 1;
+    }
+
+    for (i = 0; i < RX_COUNT; i++) {
+        if ((streams[i].f = fopen(argv[optind + i], "rb")) == NULL) {
+            perror(argv[optind + i]);
+            return 1;
+        }
+        stream_next(&streams[i]);
+        gps_init(&hgps[i]);
+        rx[i] = &hgps[i];
+    }
+    gps_fusion_init(&hfusion, rx, RX_COUNT);
+    hfusion.max_sep = max_sep;
+    hfusion.max_alt = max_alt;
+    hfusion.blend = (uint8_t)blend;
+
+    for (;;) {                                  /* Process earliest line of all streams */
+        next = -1;
+        for (i = 0; i < RX_COUNT; i++) {
+            if (streams[i].f != NULL && (next < 0 || streams[i].t < streams[next].t)) {
+                next = i;
+            }
+        }
+        if (next < 0) {
+            break;
+        }
+        gps_process(&hgps[next], streams[next].line, strlen(streams[next].line));
+        while (gps_fusion_update(&hfusion, &out)) {
+            print_out(&out);
+            epochs++;
+            disagree += out.disagree;
+            blended += out.blended;
+        }
+        stream_next(&streams[next]);
+    }
+    while (gps_fusion_flush(&hfusion, &out)) {
+        print_out(&out);
+        epochs++;
+        disagree += out.disagree;
+        blended += out.blended;
+    }
+
+    fprintf(stderr, "%lu epochs, %lu blended, %lu disagree\n", epochs, blended, disagree);
+    return 0;
+}
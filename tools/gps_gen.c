@@ -0,0 +1,540 @@
+/*
+ * gps_gen.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ *
+ *  Synthetic NMEA stream generator, standard corpus for throughput, latency and
+ *  accuracy benchmarks. Simulates rocket flight (pad, boost, coast, apogee, drogue
+ *  and main descent, landed) and emits GGA, RMC and VTG every epoch, GSA and GSV
+ *  once per second for every constellation. Output is reproducible for given seed.
+ *
+ *  Ground truth file has one CSV line per epoch: time since start, UTC, true position
+ *  (altitude above mean sea level) and velocity, flight phase and whether GGA of epoch was emitted intact.
+ *
+ *  Build:  cc -O2 gps_gen.c -lm -o gps_gen
+ *  Usage:  gps_gen [options] > file.nmea
+ *          -s seed         random seed, default 1
+ *          -r rate         epochs per second, default 10
+ *          -d seconds      duration, default 300
+ *          -t talkers      constellations, GP,GL,GA,GB or BD, default GP
+ *          -S sentences    GGA,RMC,VTG,GSA,GSV, default all
+ *          -p digits       decimals of minutes of latitude and longitude, default 4
+ *          -n sigma        horizontal position noise in meters, vertical is twice, default 1.5
+ *          -c rate         probability of wrong checksum per sentence, default 0
+ *          -x rate         probability of dropped byte, default 0
+ *          -l lat,lon,alt  launch pad, default Spaceport America
+ *          -u time         UTC of first epoch, YYYY-MM-DDTHH:MM:SS, default 2026-06-20T17:59:50
+ *          -g file         ground truth CSV
+ *          -o file         output instead of standard output
+ */
+
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE     200809L             /* getopt */
+#endif
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define PI                  3.14159265358979323846
+#define DEG                 (PI / 180.0)
+#define G0                  9.80665             /* Gravity in m/s^2 */
+#define WGS84_A             6378137.0           /* Semi-major axis in meters */
+#define WGS84_E2            6.69437999014e-3    /* First eccentricity squared */
+#define MS_TO_KNOTS         1.943844
+
+/* Flight profile */
+#define PAD_TIME            10.0                /* Seconds on pad before ignition */
+#define BURN_TIME           4.0                 /* Motor burn time in seconds */
+#define THRUST_ACC          110.0               /* Thrust acceleration in m/s^2 */
+#define DRAG_K              0.0006              /* Drag acceleration per squared speed, in 1/m */
+#define RAIL_TILT           5.0                 /* Launch rail tilt from vertical in degrees */
+#define RAIL_AZIMUTH        80.0                /* Launch rail azimuth in degrees */
+#define DROGUE_RATE         25.0                /* Descent rate under drogue in m/s */
+#define MAIN_RATE           6.0                 /* Descent rate under main in m/s */
+#define MAIN_ALT            450.0               /* Main deploy altitude above pad in meters */
+#define WIND_SPEED          5.0                 /* Wind speed in m/s */
+#define WIND_FROM           250.0               /* Wind direction, from, in degrees */
+#define WIND_TAU            2.0                 /* Time constant of drift towards wind speed, in seconds */
+#define GEOID_SEP           -22.4               /* Geoid separation at pad in meters */
+
+#define MAX_TALKERS         4
+#define MAX_SATS            12                  /* Satellites in view per constellation */
+#define SUBSTEPS            10                  /* Integration steps per epoch */
+
+#define SEN_GGA             0x01
+#define SEN_RMC             0x02
+#define SEN_VTG             0x04
+#define SEN_GSA             0x08
+#define SEN_GSV             0x10
+
+/**
+ * \brief           Flight phases
+ */
+typedef enum {
+    PHASE_PAD = 0,
+    PHASE_BOOST,
+    PHASE_COAST,
+    PHASE_DROGUE,
+    PHASE_MAIN,
+    PHASE_LANDED,
+} phase_t;
+
+static const char* phase_names[] = { "pad", "boost", "coast", "drogue", "main", "landed" };
+
+/**
+ * \brief           Satellite in view
+ */
+typedef struct {
+    double elev;                                /*!< Elevation in degrees */
+    double az;                                  /*!< Azimuth in degrees */
+    double rate;                                /*!< Azimuth change in degrees per second */
+    double snr;                                 /*!< Mean signal to noise ratio in dB-Hz */
+    uint8_t prn;                                /*!< Satellite number */
+} sat_t;
+
+/**
+ * \brief           Constellation
+ */
+typedef struct {
+    char talker[3];                             /*!< Talker ID */
+    uint8_t prn_first;                          /*!< First satellite number */
+    uint8_t prn_count;                          /*!< Number of satellite numbers */
+    sat_t sats[MAX_SATS];                       /*!< Satellites in view */
+    size_t count;                               /*!< Number of satellites in view */
+} constellation_t;
+
+/**
+ * \brief           Vehicle state in local frame, east-north-up relative to pad
+ */
+typedef struct {
+    double e, n, u;                             /*!< Position in meters */
+    double ve, vn, vu;                          /*!< Velocity in m/s */
+    phase_t phase;                              /*!< Flight phase */
+} state_t;
+
+/**
+ * \brief           Generator options and output state
+ */
+typedef struct {
+    double rate;                                /*!< Epochs per second */
+    double duration;                            /*!< Duration in seconds */
+    double sigma;                               /*!< Horizontal noise in meters */
+    double crc_rate;                            /*!< Probability of wrong checksum */
+    double drop_rate;                           /*!< Probability of dropped byte */
+    double lat0, lon0, alt0;                    /*!< Launch pad */
+    int digits;                                 /*!< Decimals of minutes */
+    unsigned sentences;                         /*!< Bit mask of emitted sentences */
+    FILE* out;                                  /*!< NMEA output */
+    int damaged;                                /*!< Last emitted sentence was damaged */
+} gen_t;
+
+static uint64_t rng_state;
+
+/**
+ * \brief           Next 64-bit random number, `splitmix64`, identical on every platform
+ */
+static uint64_t
+rng_next(void) {
+    uint64_t z = (rng_state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * \brief           Uniform random number in range `[0, 1)`
+ */
+static double
+rng_uniform(void) {
+    return (double)(rng_next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * \brief           Normal random number with zero mean and unit deviation
+ */
+static double
+rng_normal(void) {
+    double u1 = rng_uniform(), u2 = rng_uniform();
+    return sqrt(-2.0 * log(u1 > 0 ? u1 : 1e-300)) * cos(2 * PI * u2);
+}
+
+/**
+ * \brief           Initialize constellation by talker ID
+ * \return          `1` on success, `0` when talker is not known
+ */
+static int
+constellation_init(constellation_t* c, const char* talker) {
+    size_t i, j;
+
+    memset(c, 0x00, sizeof(*c));
+    if (!strncmp(talker, "GP", 2)) {
+        c->prn_first = 1; c->prn_count = 32; c->count = 10;
+    } else if (!strncmp(talker, "GL", 2)) {
+        c->prn_first = 65; c->prn_count = 24; c->count = 7;
+    } else if (!strncmp(talker, "GA", 2)) {
+        c->prn_first = 1; c->prn_count = 36; c->count = 6;
+    } else if (!strncmp(talker, "GB", 2) || !strncmp(talker, "BD", 2)) {
+        c->prn_first = 1; c->prn_count = 63; c->count = 8;
+    } else {
+        return 0;
+    }
+    memcpy(c->talker, talker, 2);
+    for (i = 0; i < c->count; i++) {
+        sat_t* s = &c->sats[i];
+        do {                                    /* Unique satellite numbers */
+            s->prn = (uint8_t)(c->prn_first + rng_next() % c->prn_count);
+            for (j = 0; j < i && c->sats[j].prn != s->prn; j++) {}
+        } while (j < i);
+        s->elev = 5 + 80 * rng_uniform();
+        s->az = 360 * rng_uniform();
+        s->rate = 0.002 + 0.004 * rng_uniform();
+        s->snr = 25 + 0.25 * s->elev;
+    }
+    return 1;
+}
+
+/**
+ * \brief           Air density factor, drag falls with altitude
+ */
+static double
+density(double alt) {
+    return exp(-alt / 8500.0);
+}
+
+/**
+ * \brief           Advance vehicle state by `dt` seconds
+ */
+static void
+step(state_t* s, double t, double dt) {
+    double v, ae = 0, an = 0, au = 0, we, wn, k;
+
+    we = -WIND_SPEED * sin(WIND_FROM * DEG);    /* Wind blows towards opposite of its direction */
+    wn = -WIND_SPEED * cos(WIND_FROM * DEG);
+    switch (s->phase) {
+        case PHASE_PAD:
+            if (t >= PAD_TIME) {
+                s->phase = PHASE_BOOST;
+            }
+            return;
+        case PHASE_BOOST:
+        case PHASE_COAST:
+            if (s->phase == PHASE_BOOST && t >= PAD_TIME + BURN_TIME) {
+                s->phase = PHASE_COAST;
+            }
+            v = sqrt(s->ve * s->ve + s->vn * s->vn + s->vu * s->vu);
+            if (s->phase == PHASE_BOOST) {
+                if (v < 1) {                    /* Leaving rail, thrust along rail */
+                    ae = THRUST_ACC * sin(RAIL_TILT * DEG) * sin(RAIL_AZIMUTH * DEG);
+                    an = THRUST_ACC * sin(RAIL_TILT * DEG) * cos(RAIL_AZIMUTH * DEG);
+                    au = THRUST_ACC * cos(RAIL_TILT * DEG);
+                } else {                        /* Gravity turn, thrust along velocity */
+                    ae = THRUST_ACC * s->ve / v;
+                    an = THRUST_ACC * s->vn / v;
+                    au = THRUST_ACC * s->vu / v;
+                }
+            }
+            k = DRAG_K * density(s->u) * v;
+            ae -= k * s->ve;
+            an -= k * s->vn;
+            au -= k * s->vu + G0;
+            s->ve += ae * dt;
+            s->vn += an * dt;
+            s->vu += au * dt;
+            if (s->phase == PHASE_COAST && s->vu <= 0) {
+                s->phase = PHASE_DROGUE;        /* Apogee */
+            }
+            break;
+        case PHASE_DROGUE:
+        case PHASE_MAIN:
+            if (s->phase == PHASE_DROGUE && s->u <= MAIN_ALT) {
+                s->phase = PHASE_MAIN;
+            }
+            s->vu += ((s->phase == PHASE_DROGUE ? -DROGUE_RATE : -MAIN_RATE) - s->vu) * dt / WIND_TAU;
+            s->ve += (we - s->ve) * dt / WIND_TAU;
+            s->vn += (wn - s->vn) * dt / WIND_TAU;
+            break;
+        default:
+            return;
+    }
+    s->e += s->ve * dt;
+    s->n += s->vn * dt;
+    s->u += s->vu * dt;
+    if (s->u <= 0 && s->phase >= PHASE_DROGUE) {
+        s->u = s->ve = s->vn = s->vu = 0;
+        s->phase = PHASE_LANDED;
+    }
+}
+
+/**
+ * \brief           Convert local position to latitude and longitude in degrees
+ */
+static void
+to_geodetic(const gen_t* g, double e, double n, double* lat, double* lon) {
+    double s = sin(g->lat0 * DEG), w = sqrt(1 - WGS84_E2 * s * s);
+    double rn = WGS84_A / w;                    /* Prime vertical radius */
+    double rm = WGS84_A * (1 - WGS84_E2) / (w * w * w); /* Meridian radius */
+
+    *lat = g->lat0 + n / rm / DEG;
+    *lon = g->lon0 + e / (rn * cos(g->lat0 * DEG)) / DEG;
+}
+
+/**
+ * \brief           Format latitude or longitude as `ddmm.mmmm,N`
+ * \param[in]       deg_digits: Number of digits of degrees, `2` or `3`
+ */
+static int
+format_angle(char* buf, size_t size, double v, int deg_digits, int digits, char pos, char neg) {
+    double a = fabs(v), scale = pow(10, digits), min;
+    long deg = (long)a;
+
+    min = floor((a - (double)deg) * 60 * scale + 0.5) / scale;
+    if (min >= 60) {                            /* Rounded up to next degree */
+        min -= 60;
+        deg++;
+    }
+    return snprintf(buf, size, "%0*ld%0*.*f,%c", deg_digits, deg, digits + 3, digits, min, v < 0 ? neg : pos);
+}
+
+/**
+ * \brief           Emit sentence body with checksum, applying configured damage
+ * \param[in]       body: Sentence without `$`, `*` and checksum
+ */
+static void
+emit(gen_t* g, const char* body) {
+    char line[128];
+    uint8_t crc = 0;
+    const char* p;
+    int n, i;
+
+    for (p = body; *p; p++) {
+        crc ^= (uint8_t)*p;
+    }
+    g->damaged = 0;
+    if (g->crc_rate > 0 && rng_uniform() < g->crc_rate) {
+        crc ^= (uint8_t)(1 + rng_next() % 255);
+        g->damaged = 1;
+    }
+    n = snprintf(line, sizeof(line), "$%s*%02X\r\n", body, (unsigned)crc);
+    if (g->drop_rate <= 0) {
+        fwrite(line, 1, (size_t)n, g->out);
+        return;
+    }
+    for (i = 0; i < n; i++) {
+        if (rng_uniform() < g->drop_rate) {
+            g->damaged = 1;
+        } else {
+            fputc(line[i], g->out);
+        }
+    }
+}
+
+/**
+ * \brief           Parse comma separated list of sentence names to bit mask
+ */
+static unsigned
+parse_sentences(const char* s) {
+    static const char* names[] = { "GGA", "RMC", "VTG", "GSA", "GSV" };
+    unsigned mask = 0, i;
+
+    for (i = 0; i < 5; i++) {
+        if (strstr(s, names[i]) != NULL) {
+            mask |= 1U << i;
+        }
+    }
+    return mask;
+}
+
+int
+main(int argc, char** argv) {
+    gen_t g = { 10, 300, 1.5, 0, 0, 32.990254, -106.974998, 1401, 4, 0x1F, NULL, 0 };
+    constellation_t cons[MAX_TALKERS];
+    state_t s = { 0 };
+    char body[112], lat_s[32], lon_s[32], pos_talker[3], list[32], *tok;
+    const char* talkers = "GP";
+    const char* truth_path = NULL;
+    const char* out_path = NULL;
+    static const uint8_t mdays[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    unsigned long seed = 1, epochs, ep, day_ms, y = 2026, mo = 6, d = 20, hh = 17, mi = 59, ss = 50;
+    uint64_t start_ms, ms, day = 0;
+    size_t nc = 0, i, j, k, in_use, msgs;
+    double t, lat, lon, alt, hdop, vdop, pdop, spd, crs;
+    FILE* truth = NULL;
+    int opt, gga_ok;
+
+    while ((opt = getopt(argc, argv, "s:r:d:t:S:p:n:c:x:l:u:g:o:")) != -1) {
+        switch (opt) {
+            case 's': seed = strtoul(optarg, NULL, 0); break;
+            case 'r': g.rate = atof(optarg); break;
+            case 'd': g.duration = atof(optarg); break;
+            case 't': talkers = optarg; break;
+            case 'S': g.sentences = parse_sentences(optarg); break;
+            case 'p': g.digits = atoi(optarg); break;
+            case 'n': g.sigma = atof(optarg); break;
+            case 'c': g.crc_rate = atof(optarg); break;
+            case 'x': g.drop_rate = atof(optarg); break;
+            case 'l':
+                if (sscanf(optarg, "%lf,%lf,%lf", &g.lat0, &g.lon0, &g.alt0) != 3) {
+                    optind = argc + 1;
+                }
+                break;
+            case 'u':
+                if (sscanf(optarg, "%lu-%lu-%luT%lu:%lu:%lu", &y, &mo, &d, &hh, &mi, &ss) != 6) {
+                    optind = argc + 1;
+                }
+                break;
+            case 'g': truth_path = optarg; break;
+            case 'o': out_path = optarg; break;
+            default: optind = argc + 1; break;
+        }
+    }
+    if (optind != argc || g.rate <= 0 || g.rate > 100 || g.duration <= 0 || g.digits < 1 || g.digits > 7
+        || g.sentences == 0 || mo < 1 || mo > 12 || d < 1 || d > 31 || hh > 23 || mi > 59 || ss > 59) {
+        fprintf(stderr, "usage: %s [-s seed] [-r rate] [-d seconds] [-t GP,GL,GA,GB] [-S GGA,RMC,VTG,GSA,GSV]\n"
+            "       [-p digits] [-n sigma] [-c crc_rate] [-x drop_rate] [-l lat,lon,alt]\n"
+            "       [-u YYYY-MM-DDTHH:MM:SS] [-g truth.csv] [-o out.nmea]\n", argv[0]);
+        return 1;
+    }
+    rng_state = seed;
+    start_ms = ((uint64_t)(hh * 60 + mi) * 60 + ss) * 1000;
+
+    /* Constellations, position sentences use GN talker when more than one is used */
+    snprintf(list, sizeof(list), "%s", talkers);
+    for (tok = strtok(list, ","); tok != NULL && nc < MAX_TALKERS; tok = strtok(NULL, ",")) {
+        if (!constellation_init(&cons[nc++], tok)) {
+            fprintf(stderr, "unknown talker %s\n", tok);
+            return 1;
+        }
+    }
+    if (nc == 0) {
+        return 1;
+    }
+    memcpy(pos_talker, nc > 1 ? "GN" : cons[0].talker, 3);
+
+    g.out = stdout;
+    if (out_path != NULL && (g.out = fopen(out_path, "wb")) == NULL) {
+        perror(out_path);
+        return 1;
+    }
+    if (truth_path != NULL) {
+        if ((truth = fopen(truth_path, "w")) == NULL) {
+            perror(truth_path);
+            return 1;
+        }
+        fprintf(truth, "t,utc,lat,lon,alt,ve,vn,vu,phase,gga_ok\n");
+    }
+
+    epochs = (unsigned long)(g.duration * g.rate + 0.5);
+    for (ep = 0; ep < epochs; ep++) {
+        t = (double)ep / g.rate;
+        if (ep > 0) {
+            for (k = 0; k < SUBSTEPS; k++) {
+                step(&s, t - (double)(SUBSTEPS - k) / (g.rate * SUBSTEPS), 1.0 / (g.rate * SUBSTEPS));
+            }
+        }
+
+        /* UTC of epoch, in milliseconds of day, date advances at midnight */
+        ms = start_ms + (uint64_t)(t * 1000 + 0.5);
+        day_ms = (unsigned long)(ms % 86400000ULL);
+        for (; day < ms / 86400000ULL; day++) {
+            unsigned long dim = mdays[mo - 1] + (mo == 2 && y % 4 == 0 && (y % 100 != 0 || y % 400 == 0));
+            if (++d > dim) {
+                d = 1;
+                if (++mo > 12) {
+                    mo = 1;
+                    y++;
+                }
+            }
+        }
+
+        /* Measured position */
+        to_geodetic(&g, s.e + g.sigma * rng_normal(), s.n + g.sigma * rng_normal(), &lat, &lon);
+        alt = g.alt0 + s.u + 2 * g.sigma * rng_normal();
+        spd = sqrt(s.ve * s.ve + s.vn * s.vn);
+        crs = fmod(atan2(s.ve, s.vn) / DEG + 360, 360);
+        format_angle(lat_s, sizeof(lat_s), lat, 2, g.digits, 'N', 'S');
+        format_angle(lon_s, sizeof(lon_s), lon, 3, g.digits, 'E', 'W');
+
+        /* Satellites move slowly, those higher than 15 degrees are used */
+        for (i = 0, in_use = 0; i < nc; i++) {
+            for (j = 0; j < cons[i].count; j++) {
+                sat_t* st = &cons[i].sats[j];
+                st->az = fmod(st->az + st->rate / g.rate, 360);
+                in_use += st->elev > 15;
+            }
+        }
+        hdop = 0.7 + 4.0 / (double)(in_use + 1);
+        vdop = 1.5 * hdop;
+        pdop = sqrt(hdop * hdop + vdop * vdop);
+
+        gga_ok = 0;
+        if (g.sentences & SEN_GGA) {
+            snprintf(body, sizeof(body), "%sGGA,%02lu%02lu%05.2f,%s,%s,1,%02u,%.1f,%.1f,M,%.1f,M,,",
+                pos_talker, day_ms / 3600000UL, day_ms / 60000UL % 60, (double)(day_ms % 60000UL) / 1000,
+                lat_s, lon_s, (unsigned)in_use, hdop, alt, GEOID_SEP);
+            emit(&g, body);
+            gga_ok = !g.damaged;
+        }
+        if (g.sentences & SEN_RMC) {
+            snprintf(body, sizeof(body), "%sRMC,%02lu%02lu%05.2f,A,%s,%s,%.2f,%.1f,%02lu%02lu%02lu,,,A",
+                pos_talker, day_ms / 3600000UL, day_ms / 60000UL % 60, (double)(day_ms % 60000UL) / 1000,
+                lat_s, lon_s, spd * MS_TO_KNOTS, crs, d, mo, y % 100);
+            emit(&g, body);
+        }
+        if (g.sentences & SEN_VTG) {
+            snprintf(body, sizeof(body), "%sVTG,%.1f,T,,M,%.2f,N,%.2f,K,A",
+                pos_talker, crs, spd * MS_TO_KNOTS, spd * 3.6);
+            emit(&g, body);
+        }
+        if (day_ms % 1000 < (unsigned long)(500 / g.rate)) { /* Once per second */
+            for (i = 0; i < nc && (g.sentences & SEN_GSA); i++) {
+                int len = snprintf(body, sizeof(body), "%sGSA,A,3", cons[i].talker);
+                for (j = 0, k = 0; j < cons[i].count; j++) {    /* Satellites used first */
+                    if (cons[i].sats[j].elev > 15) {
+                        len += snprintf(&body[len], sizeof(body) - (size_t)len, ",%02u", (unsigned)cons[i].sats[j].prn);
+                        k++;
+                    }
+                }
+                for (; k < 12; k++) {           /* Empty fields up to 12 */
+                    len += snprintf(&body[len], sizeof(body) - (size_t)len, ",");
+                }
+                snprintf(&body[len], sizeof(body) - (size_t)len, ",%.1f,%.1f,%.1f", pdop, hdop, vdop);
+                emit(&g, body);
+            }
+            for (i = 0; i < nc && (g.sentences & SEN_GSV); i++) {
+                msgs = (cons[i].count + 3) / 4;
+                for (j = 0; j < msgs; j++) {
+                    int len = snprintf(body, sizeof(body), "%sGSV,%u,%u,%02u", cons[i].talker,
+                        (unsigned)msgs, (unsigned)(j + 1), (unsigned)cons[i].count);
+                    for (k = 4 * j; k < cons[i].count && k < 4 * j + 4; k++) {
+                        sat_t* st = &cons[i].sats[k];
+                        len += snprintf(&body[len], sizeof(body) - (size_t)len, ",%02u,%02d,%03d,%02d",
+                            (unsigned)st->prn, (int)st->elev, (int)st->az, (int)(st->snr + 2 * rng_normal()));
+                    }
+                    emit(&g, body);
+                }
+            }
+        }
+
+        if (truth != NULL) {
+            double tlat, tlon;
+            to_geodetic(&g, s.e, s.n, &tlat, &tlon);
+            fprintf(truth, "%.3f,%02lu:%02lu:%06.3f,%.9f,%.9f,%.3f,%.3f,%.3f,%.3f,%s,%d\n",
+                (double)ep / g.rate, day_ms / 3600000UL, day_ms / 60000UL % 60,
+                (double)(day_ms % 60000UL) / 1000, tlat, tlon, g.alt0 + s.u,
+                s.ve, s.vn, s.vu, phase_names[s.phase], gga_ok);
+        }
+    }
+
+    if (truth != NULL) {
+        fclose(truth);
+    }
+    if (g.out != stdout) {
+        fclose(g.out);
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+/*
+ * gps_replay.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ *
+ *  Replays recorded NMEA stream through pseudo terminal at serial line rate,
+ *  so host tools can be tested against it as if it was a receiver.
+ *  Path of terminal to open is printed on standard output.
+ *
+ *  Build:  cc -O2 gps_replay.c -o gps_replay
+ *  Usage:  gps_replay [-b baud] [-l] <file.nmea>
+ */
+
+#define _XOPEN_SOURCE       600                 /* posix_openpt */
+#define _DEFAULT_SOURCE                         /* cfmakeraw */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+int
+main(int argc, char** argv) {
+    struct termios tio;
+    struct timespec ts;
+    char data[64];
+    long baud = 9600, loop = 0;
+    size_t n;
+    FILE* f;
+    int opt, pty;
+
+    while ((opt = getopt(argc, argv, "b:l")) != -1) {
+        switch (opt) {
+            case 'b': baud = strtol(optarg, NULL, 0); break;
+            case 'l': loop = 1; break;
+            default:
+                fprintf(stderr, "usage: %s [-b baud] [-l] <file.nmea>\n", argv[0]);
+                return 1;
+        }
+    }
+    if (optind >= argc || baud <= 0 || (f = fopen(argv[optind], "rb")) == NULL) {
+        fprintf(stderr, "cannot open input\n");
+        return 1;
+    }
+
+    pty = posix_openpt(O_RDWR | O_NOCTTY);
+    if (pty < 0 || grantpt(pty) != 0 || unlockpt(pty) != 0) {
+        perror("posix_openpt");
+        return 1;
+    }
+    if (tcgetattr(pty, &tio) == 0) {            /* No echo or line editing of replayed data */
+        cfmakeraw(&tio);
+        tcsetattr(pty, TCSANOW, &tio);
+    }
+    printf("%s\n", ptsname(pty));
+    fflush(stdout);
+
+    /* 10 bits per byte on 8-N-1 line, send in small chunks to keep timing */
+    ts.tv_sec = 0;
+    ts.tv_nsec = (long)(sizeof(data) * 10 * 1000000000LL / baud);
+    do {
+        rewind(f);
+        while ((n = fread(data, 1, sizeof(data), f)) > 0) {
+            if (write(pty, data, n) != (ssize_t)n) {
+                break;
+            }
+            nanosleep(&ts, NULL);
+        }
+    } while (loop);
+
+    fclose(f);
+    close(pty);
+    return 0;
+}
@@ -0,0 +1,123 @@
+/*
+ * gps_shm.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ *
+ *  Shared memory ring with fixes published by gps_daemon. Single writer,
+ *  any number of readers, no locks and no system calls on read path.
+ *  Each slot is protected by a sequence number: odd while slot is written.
+ */
+
+#ifndef GPS_SHM_H_
+#define GPS_SHM_H_
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "gps.h"
+
+#define GPS_SHM_MAGIC               0x47505331UL    /* "GPS1" */
+#define GPS_SHM_SLOTS               64              /* Number of slots, power of 2 */
+
+/**
+ * \brief           Fix published to shared memory
+ */
+typedef struct {
+    uint64_t seq;                               /*!< Sequence number of fix, starts with `1` */
+    uint64_t rx_ns;                             /*!< Host monotonic time when fix was received, in nanoseconds */
+    gps_fix_t fix;                              /*!< Fix values */
+} gps_shm_fix_t;
+
+/**
+ * \brief           Single slot of ring
+ */
+typedef struct {
+    _Atomic uint64_t lock;                      /*!< `2 * seq` when slot is stable, odd while written */
+    gps_shm_fix_t data;                         /*!< Published fix */
+} gps_shm_slot_t;
+
+/**
+ * \brief           Shared memory layout
+ */
+typedef struct {
+    uint32_t magic;                             /*!< Set to \ref GPS_SHM_MAGIC when initialized */
+    uint32_t fix_size;                          /*!< `sizeof(gps_fix_t)` of writer, readers built with different configuration must not read */
+    _Atomic uint64_t head;                      /*!< Sequence number of last published fix, `0` when none */
+    gps_shm_slot_t slots[GPS_SHM_SLOTS];        /*!< Ring of fixes */
+} gps_shm_t;
+
+/**
+ * \brief           Check shared memory is initialized and compatible
+ * \param[in]       shm: Mapped shared memory
+ * \return          `1` when compatible, `0` otherwise
+ */
+static inline uint8_t
+gps_shm_valid(const gps_shm_t* shm) {
+    return shm->magic == GPS_SHM_MAGIC && shm->fix_size == sizeof(gps_fix_t);
+}
+
+/**
+ * \brief           Publish new fix, writer only
+ * \param[in]       shm: Mapped shared memory
+ * \param[in]       fix: Fix to publish, `seq` is set by function
+ */
+static inline void
+gps_shm_publish(gps_shm_t* shm, gps_shm_fix_t* fix) {
+    uint64_t seq = atomic_load_explicit(&shm->head, memory_order_relaxed) + 1;
+    gps_shm_slot_t* s = &shm->slots[seq & (GPS_SHM_SLOTS - 1)];
+
+    fix->seq = seq;
+    atomic_store_explicit(&s->lock, 2 * seq - 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    memcpy(&s->data, fix, sizeof(s->data));
+    atomic_store_explicit(&s->lock, 2 * seq, memory_order_release);
+    atomic_store_explicit(&shm->head, seq, memory_order_release);
+}
+
+/**
+ * \brief           Read fix with given sequence number
+ * \param[in]       shm: Mapped shared memory
+ * \param[in]       seq: Sequence number to read
+ * \param[out]      fix: Output fix
+ * \return          `1` on success, `0` when fix is not published yet or was already overwritten
+ */
+static inline uint8_t
+gps_shm_read(const gps_shm_t* shm, uint64_t seq, gps_shm_fix_t* fix) {
+    const gps_shm_slot_t* s = &shm->slots[seq & (GPS_SHM_SLOTS - 1)];
+    uint64_t l1, l2;
+
+    if (seq == 0) {
+        return 0;
+    }
+    l1 = atomic_load_explicit(&s->lock, memory_order_acquire);
+    if (l1 != 2 * seq) {
+        return 0;
+    }
+    memcpy(fix, (const void *)&s->data, sizeof(*fix));
+    atomic_thread_fence(memory_order_acquire);
+    l2 = atomic_load_explicit(&s->lock, memory_order_relaxed);
+    return l1 == l2;
+}
+
+/**
+ * \brief           Read last published fix
+ * \param[in]       shm: Mapped shared memory
+ * \param[out]      fix: Output fix
+ * \return          `1` on success, `0` when nothing is published yet
+ */
+static inline uint8_t
+gps_shm_read_latest(const gps_shm_t* shm, gps_shm_fix_t* fix) {
+    uint64_t seq;
+
+    do {                                        /* Retry when writer overtook us */
+        seq = atomic_load_explicit(&shm->head, memory_order_acquire);
+        if (seq == 0) {
+            return 0;
+        }
+    } while (!gps_shm_read(shm, seq, fix));
+    return 1;
+}
+
+#endif /* GPS_SHM_H_ */
@@ -0,0 +1,56 @@
+/*
+ * gps_shm_cat.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ *
+ *  Example consumer of gps_daemon shared memory. Prints every new fix.
+ *
+ *  Build:  cc -O2 -std=c11 -I.. gps_shm_cat.c -lrt -o gps_shm_cat
+ *  Usage:  gps_shm_cat [/shm_name]
+ */
+
+#define _DEFAULT_SOURCE                         /* shm_open, usleep */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "gps_shm.h"
+
+int
+main(int argc, char** argv) {
+    const gps_shm_t* shm;
+    gps_shm_fix_t f;
+    uint64_t next = 0;
+    int fd;
+
+    fd = shm_open(argc > 1 ? argv[1] : "/gps0", O_RDONLY, 0);
+    if (fd < 0) {
+        perror("shm_open");
+        return 1;
+    }
+    shm = mmap(NULL, sizeof(*shm), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (shm == MAP_FAILED || !gps_shm_valid(shm)) {
+        fprintf(stderr, "shared memory not initialized or built with different configuration\n");
+        return 1;
+    }
+
+    for (;;) {
+        if (next == 0 || !gps_shm_read(shm, next, &f)) {
+            if (!gps_shm_read_latest(shm, &f) || f.seq < next) {
+                usleep(10000);                  /* Nothing new, poll again later */
+                continue;
+            }
+        }
+        printf("%llu: %.6f %.6f alt %.1f fix %u sats %u %02u:%02u:%02u\n", (unsigned long long)f.seq,
+            f.fix.gga.latitude, f.fix.gga.longitude, (double)f.fix.gga.altitude, (unsigned)f.fix.gga.fix,
+            (unsigned)f.fix.gga.sats_in_use, (unsigned)f.fix.gga.hours, (unsigned)f.fix.gga.minutes,
+            (unsigned)f.fix.gga.seconds);
+        fflush(stdout);
+        next = f.seq + 1;
+    }
+    return 0;
+}
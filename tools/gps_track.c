@@ -0,0 +1,194 @@
+/*
+ * gps_track.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: junaidkhan
+ *
+ *  Host track analysis. Parses recorded NMEA stream into arrays of fixes, then runs
+ *  batch geodesy kernels relative to launch pad (first fix or `-r`) and prints
+ *  summary with throughput of each kernel.
+ *
+ *  Build:  cc -O3 -ffast-math -march=x86-64-v3 -I.. gps_track.c ../gps.c ../gps_buff.c ../gps_prof.c ../gps_geo.c -lm -o gps_track
+ *  Usage:  gps_track [-r lat,lon,alt] [-n repeat] [-c] <file.nmea>
+ *          -c prints CSV line per fix: time, range, bearing, east, north, up
+ */
+
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE     200809L             /* clock_gettime, getopt */
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "gps.h"
+#include "gps_geo.h"
+
+/**
+ * \brief           Track as structure of arrays
+ */
+typedef struct {
+    gps_float_t* lat;                           /*!< Latitudes in degrees */
+    gps_float_t* lon;                           /*!< Longitudes in degrees */
+    gps_float_t* alt;                           /*!< Altitudes above ellipsoid in meters */
+    gps_epoch_t* utc;                           /*!< UTC epoch of fix */
+    size_t n;                                   /*!< Number of fixes */
+    size_t cap;                                 /*!< Allocated number of fixes */
+} track_t;
+
+static gps_t hgps;
+
+/**
+ * \brief           Get monotonic time in units of seconds
+ */
+static double
+now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * \brief           Append fix to track
+ * \return          `1` on success, `0` when out of memory
+ */
+static int
+track_add(track_t* t, const gps_gga_t* gga) {
+    if (t->n == t->cap) {
+        size_t cap = t->cap ? 2 * t->cap : 4096;
+        gps_float_t* lat = realloc(t->lat, cap * sizeof(*lat));
+        gps_float_t* lon = realloc(t->lon, cap * sizeof(*lon));
+        gps_float_t* alt = realloc(t->alt, cap * sizeof(*alt));
+        gps_epoch_t* utc = realloc(t->utc, cap * sizeof(*utc));
+        if (lat != NULL) t->lat = lat;
+        if (lon != NULL) t->lon = lon;
+        if (alt != NULL) t->alt = alt;
+        if (utc != NULL) t->utc = utc;
+        if (lat == NULL || lon == NULL || alt == NULL || utc == NULL) {
+            return 0;
+        }
+        t->cap = cap;
+    }
+    t->lat[t->n] = gga->latitude;
+    t->lon[t->n] = gga->longitude;
+    t->alt[t->n] = (gps_float_t)gga->altitude + (gps_float_t)gga->geo_sep;
+    t->utc[t->n] = gga->epoch;
+    t->n++;
+    return 1;
+}
+
+/**
+ * \brief           Print throughput of kernel run
+ */
+static void
+report(const char* name, double sec, size_t points) {
+    printf("%-16s %8.2f Mpoints/s  %8.1f MB/s\n", name, (double)points / sec * 1e-6,
+        (double)points * 3 * sizeof(gps_float_t) / sec * 1e-6);
+}
+
+int
+main(int argc, char** argv) {
+    track_t t = { 0 };
+    gps_geo_ref_t ref;
+    gps_fix_t fix;
+    gps_float_t *range, *brg, *seg, *e, *nn, *u;
+    gps_float_t max_range = 0, max_up = 0, length = 0;
+    double ref_lat = 0, ref_lon = 0, ref_alt = 0, t0;
+    char line[256];
+    gps_epoch_t last_key = GPS_EPOCH_NONE;
+    int opt, has_ref = 0, csv = 0, repeat = 10, r;
+    size_t i;
+    FILE* f;
+
+    while ((opt = getopt(argc, argv, "r:n:c")) != -1) {
+        switch (opt) {
+            case 'r':
+                has_ref = sscanf(optarg, "%lf,%lf,%lf", &ref_lat, &ref_lon, &ref_alt) == 3;
+                break;
+            case 'n': repeat = atoi(optarg); break;
+            case 'c': csv = 1; break;
+            default: optind = argc; break;
+        }
+    }
+    if (optind != argc - 1 || repeat < 1) {
+        fprintf(stderr, "usage: %s [-r lat,lon,alt] [-n repeat] [-c] <file.nmea>\n", argv[0]);
+        return 1;
+    }
+    if ((f = strcmp(argv[optind], "-") ? fopen(argv[optind], "rb") : stdin) == NULL) {
+        perror(argv[optind]);
+        return 1;
+    }
+
+    gps_init(&hgps);
+    while (fgets(line, sizeof(line), f) != NULL) {
+        gps_process(&hgps, line, strlen(line));
+        gps_get_fix(&hgps, &fix);
+        if (fix.gga.fix && fix.gga.timed && fix.gga.epoch != last_key) {   /* New valid epoch */
+            last_key = fix.gga.epoch;
+            if (!track_add(&t, &fix.gga)) {
+                fprintf(stderr, "out of memory\n");
+                return 1;
+            }
+        }
+    }
+    if (f != stdin) {
+        fclose(f);
+    }
+    if (t.n == 0) {
+        fprintf(stderr, "no valid fixes\n");
+        return 1;
+    }
+    if (!has_ref) {                             /* Launch pad is first fix */
+        ref_lat = t.lat[0];
+        ref_lon = t.lon[0];
+        ref_alt = t.alt[0];
+    }
+    gps_geo_ref_init(&ref, ref_lat, ref_lon, ref_alt);
+
+    range = malloc(t.n * sizeof(*range));
+    brg = malloc(t.n * sizeof(*brg));
+    seg = malloc(t.n * sizeof(*seg));
+    e = malloc(t.n * sizeof(*e));
+    nn = malloc(t.n * sizeof(*nn));
+    u = malloc(t.n * sizeof(*u));
+    if (range == NULL || brg == NULL || seg == NULL || e == NULL || nn == NULL || u == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    t0 = now_sec();
+    for (r = 0; r < repeat; r++) gps_geo_range(&ref, t.lat, t.lon, range, t.n);
+    report("range", now_sec() - t0, t.n * (size_t)repeat);
+    t0 = now_sec();
+    for (r = 0; r < repeat; r++) gps_geo_bearing(&ref, t.lat, t.lon, brg, t.n);
+    report("bearing", now_sec() - t0, t.n * (size_t)repeat);
+    t0 = now_sec();
+    for (r = 0; r < repeat; r++) gps_geo_track(t.lat, t.lon, seg, t.n);
+    report("track", now_sec() - t0, t.n * (size_t)repeat);
+    t0 = now_sec();
+    for (r = 0; r < repeat; r++) gps_geo_to_enu(&ref, t.lat, t.lon, t.alt, e, nn, u, t.n);
+    report("enu", now_sec() - t0, t.n * (size_t)repeat);
+
+    for (i = 0; i < t.n; i++) {
+        max_range = range[i] > max_range ? range[i] : max_range;
+        max_up = u[i] > max_up ? u[i] : max_up;
+        length += seg[i];
+        if (csv) {
+            uint64_t ms = t.utc[i] / 1000 % 86400000ULL;
+
+            printf("%02u:%02u:%02u.%03u,%.2f,%.2f,%.2f,%.2f,%.2f\n", (unsigned)(ms / 3600000),
+                (unsigned)(ms / 60000 % 60), (unsigned)(ms / 1000 % 60), (unsigned)(ms % 1000),
+                (double)range[i], (double)brg[i], (double)e[i], (double)nn[i], (double)u[i]);
+        }
+    }
+    printf("fixes %lu, track %.1f m, max range %.1f m (Vincenty %.1f m at last fix), max up %.1f m\n",
+        (unsigned long)t.n, (double)length, (double)max_range,
+        (double)gps_geo_vincenty(ref.latitude, ref.longitude, t.lat[t.n - 1], t.lon[t.n - 1], NULL),
+        (double)max_up);
+
+    free(range); free(brg); free(seg); free(e); free(nn); free(u);
+    free(t.lat); free(t.lon); free(t.alt); free(t.utc);
+    return 0;
+}